@@ -0,0 +1,108 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: current_limiter_test.cpp
+// Host test of the current sense loop: SimulatedCurrentSource -> CurrentLimiter::update -> trim back into
+// the simulated strip, the way LedStrip runs it once per frame. Built and run by scripts/host_test.sh
+#include "../../src/Interfaces/Hardware/LedStrip/CurrentSense/CurrentLimiter.h"
+#include "../../src/Interfaces/Hardware/LedStrip/CurrentSense/SimulatedCurrentSource.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+
+static int failures = 0;
+
+static void check(bool condition, const char* what, long value) {
+    std::printf("%s %s (%ld)\n", condition ? "ok  " : "FAIL", what, value);
+    if (!condition) failures++;
+}
+
+struct Run {
+    uint32_t    last_ma         = 0;
+    uint32_t    peak_ma         = 0;
+    // readings above budget + 2% after the first one of the run
+    int         over_readings   = 0;
+    // first reading from which every later one stays within 2% of the target
+    int         settled_at      = -1;
+};
+
+// one reading per frame, the trim of a reading only reaches the strip on the next frame
+static Run run(CurrentLimiter& limiter, SimulatedCurrentSource& source, int readings, uint32_t target_ma) {
+    Run result;
+    for (int i = 0; i < readings; i++) {
+        uint32_t sample_ma = 0;
+        source.read_ma(sample_ma);
+        source.set_output_scale_q16(limiter.update(sample_ma));
+        result.last_ma = sample_ma;
+        if (i > 0 && sample_ma > result.peak_ma) result.peak_ma = sample_ma;
+        uint32_t budget = limiter.get_budget_ma();
+        if (i > 0 && budget != 0 && sample_ma * 100 > budget * 102u) result.over_readings++;
+        bool near = sample_ma * 100 >= target_ma * 98u && sample_ma * 100 <= target_ma * 102u;
+        if (!near) result.settled_at = -1;
+        else if (result.settled_at < 0) result.settled_at = i;
+    }
+    return result;
+}
+
+int main() {
+    const uint32_t idle_ma   = 300;
+    const uint32_t budget_ma = 2000;
+
+    // full white needs 5 A, the limit holds the total at the budget with the idle draw untrimmed
+    SimulatedCurrentSource source(idle_ma);
+    source.set_load_ma(5000);
+    CurrentLimiter limiter(budget_ma, idle_ma);
+    Run cut = run(limiter, source, 50, budget_ma);
+    check(cut.settled_at >= 0 && cut.settled_at <= 2, "cut settles on the budget at once", cut.settled_at);
+    check(cut.over_readings == 0, "no reading over the budget after the cut", cut.over_readings);
+    long expected_trim = (budget_ma - idle_ma) * 65536L / 5000;
+    long trim = limiter.get_trim_q16();
+    check(std::labs(trim - expected_trim) <= expected_trim / 50, "trim is (budget - idle) / load", trim);
+    check(std::labs(static_cast<long>(limiter.get_demand_ma()) - 5300) <= 50, "demand is the draw at full output", limiter.get_demand_ma());
+
+    // the load doubles mid-run: the filter needs a few readings, then the budget holds again
+    source.set_load_ma(10000);
+    Run step = run(limiter, source, 100, budget_ma);
+    check(step.settled_at >= 0 && step.settled_at <= 40, "load step settles on the budget", step.settled_at);
+    check(step.peak_ma * 100 <= budget_ma * 200u, "load step overshoot stays below 2x budget", step.peak_ma);
+
+    // the load drops below the budget: the trim recovers to full output
+    source.set_load_ma(1000);
+    Run release = run(limiter, source, 300, idle_ma + 1000);
+    check(limiter.get_trim_q16() == CurrentLimiter::TRIM_ONE, "trim recovers to full output", limiter.get_trim_q16());
+    check(release.over_readings == 0, "recovery does not overshoot the budget", release.over_readings);
+
+    // the budget below the idle draw leaves only the minimum trim
+    limiter.set_budget_ma(200);
+    source.set_load_ma(5000);
+    run(limiter, source, 50, 0);
+    check(limiter.get_trim_q16() == CurrentLimiter::TRIM_MIN, "budget under idle holds the minimum trim", limiter.get_trim_q16());
+
+    // a dark strip with the budget under idle: nothing to divide by, the minimum trim holds
+    {
+        CurrentLimiter dark(200, idle_ma);
+        for (uint32_t sample_ma : {250u, 0u, 300u, 250u}) dark.update(sample_ma);
+        check(dark.get_trim_q16() == CurrentLimiter::TRIM_MIN, "dark strip, budget under idle holds the minimum trim",
+              dark.get_trim_q16());
+        SimulatedCurrentSource dark_source(idle_ma);
+        Run dark_run = run(dark, dark_source, 50, idle_ma);
+        check(dark_run.last_ma == idle_ma, "dark strip keeps drawing only idle", dark_run.last_ma);
+    }
+
+    // 0 disables the limit
+    limiter.set_budget_ma(0);
+    Run open = run(limiter, source, 300, idle_ma + 5000);
+    check(open.settled_at >= 0, "no budget, full output", open.last_ma);
+
+    std::printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,94 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: frame_stats_test.cpp
+// Host test of FrameStats: bucket edges, percentiles, the deferred reset, dropped frame counting and
+// snapshots taken while another thread records. Built and run by scripts/host_test.sh
+#include "../../src/Interfaces/Hardware/LedStrip/FrameStats/FrameStats.h"
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+static int failures = 0;
+
+static void check(bool condition, const char* what, long value) {
+    std::printf("%s %s (%ld)\n", condition ? "ok  " : "FAIL", what, value);
+    if (!condition) failures++;
+}
+
+static uint32_t bucket_total(const FrameStats::Stage& s) {
+    uint32_t total = 0;
+    for (uint32_t n : s.buckets) total += n;
+    return total;
+}
+
+int main() {
+    // every bucket ends where the next one starts, and is at most 25 % wide
+    int bad_edges = 0;
+    for (uint8_t i = 0; i + 1 < FrameStats::BUCKETS; i++) {
+        uint32_t upper = FrameStats::bucket_upper_us(i);
+        uint32_t lower = i ? FrameStats::bucket_upper_us(i - 1) + 1 : 0;
+        if (FrameStats::bucket(upper) != i || FrameStats::bucket(upper + 1) != i + 1) bad_edges++;
+        if (i >= 4 && (upper - lower + 1) * 4 > lower) bad_edges++;
+    }
+    check(bad_edges == 0, "bucket edges are contiguous and at most 25 % wide", bad_edges);
+    check(FrameStats::bucket(UINT32_MAX) == FrameStats::BUCKETS - 1, "overflow lands in the last bucket",
+          FrameStats::bucket(UINT32_MAX));
+
+    // 1..1000 us: exact min, max and average, p99 within its bucket and never above max
+    FrameStats stats;
+    for (uint32_t us = 1; us <= 1000; us++) stats.record(FrameStage::RENDER, us);
+    FrameStats::Stage render = stats.snapshot(FrameStage::RENDER);
+    check(render.count == 1000 && bucket_total(render) == 1000, "every record lands in a bucket", bucket_total(render));
+    check(render.min_us == 1 && render.max_us == 1000, "min and max are exact", render.max_us);
+    check(render.avg_us() == 500, "average is exact", render.avg_us());
+    uint32_t p99 = render.percentile_us(990);
+    check(p99 >= 990 && p99 * 4 <= 990 * 5 && p99 <= render.max_us, "p99 is the upper edge of its bucket", p99);
+    check(render.percentile_us(1000) == 1000, "p100 is clamped to max", render.percentile_us(1000));
+    check(stats.snapshot(FrameStage::SHOW).count == 0, "stages are independent", stats.snapshot(FrameStage::SHOW).count);
+
+    // a frame 2.6 periods late misses 2, half a period late is still on time
+    stats.record_interval(26000, 10000);
+    stats.record_interval(15000, 10000);
+    stats.record_interval(10000, 0);
+    check(stats.get_dropped() == 2, "late frames count whole missed periods", stats.get_dropped());
+
+    // reset is applied by each stage's writer on its next record
+    stats.reset();
+    check(stats.snapshot(FrameStage::RENDER).count == 1000, "reset waits for the writer", stats.snapshot(FrameStage::RENDER).count);
+    stats.record(FrameStage::RENDER, 7);
+    render = stats.snapshot(FrameStage::RENDER);
+    check(render.count == 1 && render.min_us == 7 && render.max_us == 7, "reset clears the stage on its next record", render.count);
+    stats.record_interval(10000, 10000);
+    check(stats.get_dropped() == 0, "reset clears the dropped frames", stats.get_dropped());
+
+    // snapshots while another thread records: the buckets of a copy always add up to its count
+    FrameStats shared;
+    std::atomic<bool> done {false};
+    std::thread writer([&] {
+        for (uint32_t i = 0; i < 2000000; i++) shared.record(FrameStage::FRAME, i % 5000);
+        done.store(true);
+    });
+    long torn = 0;
+    long copies = 0;
+    while (!done.load()) {
+        FrameStats::Stage s = shared.snapshot(FrameStage::FRAME);
+        if (bucket_total(s) != s.count) torn++;
+        copies++;
+    }
+    writer.join();
+    std::printf("     %ld snapshots during the run\n", copies);
+    check(torn == 0, "snapshots taken during record are consistent", torn);
+
+    std::printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,119 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: hsv_convert_test.cpp
+// Compares the integer HSV <-> RGB of HsvConvert.h with the float code LedMode used before, over every
+// input. The float code rounds at x.5 and truncates at whole steps with float error, the integer code
+// with exact math, so single channels differ by 1 LSB on boundary inputs. The test fails on anything
+// larger. Built and run by scripts/host_test.sh
+#include "../../src/Interfaces/Hardware/LedStrip/LedModes/HsvConvert.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace reference {
+
+// Arduino map()
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+float fract(float x)                    { return x - int(x); }
+float mix(float a, float b, float t)    { return a + (b - a) * t; }
+float step(float e, float x)            { return x < e ? 0.0f : 1.0f; }
+
+std::array<uint8_t, 3> rgb_to_hsv(std::array<uint8_t, 3> input_rgb) {
+    float r = input_rgb[0] / 255.0f;
+    float g = input_rgb[1] / 255.0f;
+    float b = input_rgb[2] / 255.0f;
+
+    float s = step(b, g);
+    float px = mix(b, g, s);
+    float py = mix(g, b, s);
+    float pz = mix(-1.0f, 0.0f, s);
+    float pw = mix(0.6666666f, -0.3333333f, s);
+    s = step(px, r);
+    float qx = mix(px, r, s);
+    float qz = mix(pw, pz, s);
+    float qw = mix(r, px, s);
+    float d = qx - std::min(qw, py);
+    float hue_float = std::fabs(qz + (qw - py) / (6.0f * d + 1e-10f));
+    float sat_float = d / (qx + 1e-10f);
+    return {(uint8_t)(hue_float * 255), (uint8_t)(sat_float * 255), (uint8_t)(qx * 255)};
+}
+
+std::array<uint8_t, 3> hsv_to_rgb(std::array<uint8_t, 3> input_hsv) {
+    float h_float = map(input_hsv[0], 0, 255, 0, 360);
+    float s_float = map(input_hsv[1], 0, 255, 0, 100);
+    float v_float = map(input_hsv[2], 0, 255, 0, 100);
+    std::array<uint8_t, 3> rgb = {0, 0, 0};
+    s_float /= 100;
+    v_float /= 100;
+    if (s_float == 0) {
+        rgb[0] = rgb[1] = rgb[2] = std::round(v_float * 255);
+        return rgb;
+    }
+    h_float /= 60;
+    int i = std::floor(h_float);
+    float f = h_float - i;
+    if (!(i & 1)) f = 1 - f;
+    float m = v_float * (1 - s_float);
+    float n = v_float * (1 - s_float * f);
+    uint8_t top = std::round(v_float * 255), bottom = std::round(m * 255), slope = std::round(n * 255);
+    switch (i) {
+        case 0:
+        case 6: rgb = {top, slope, bottom}; break;
+        case 1: rgb = {slope, top, bottom}; break;
+        case 2: rgb = {bottom, top, slope}; break;
+        case 3: rgb = {bottom, slope, top}; break;
+        case 4: rgb = {slope, bottom, top}; break;
+        case 5: rgb = {top, bottom, slope}; break;
+    }
+    return rgb;
+}
+
+}  // namespace reference
+
+struct Compare {
+    long    inputs      = 0;
+    long    differing   = 0;
+    int     max_diff    = 0;
+};
+
+static void compare(Compare& result, const std::array<uint8_t, 3>& expected, const std::array<uint8_t, 3>& actual) {
+    int diff = 0;
+    for (size_t c = 0; c < 3; c++) diff = std::max(diff, std::abs(expected[c] - actual[c]));
+    result.inputs++;
+    if (diff) result.differing++;
+    result.max_diff = std::max(result.max_diff, diff);
+}
+
+int main() {
+    Compare to_rgb, to_hsv;
+    for (int a = 0; a < 256; a++) {
+        for (int b = 0; b < 256; b++) {
+            for (int c = 0; c < 256; c++) {
+                std::array<uint8_t, 3> in = {(uint8_t)a, (uint8_t)b, (uint8_t)c};
+                std::array<uint8_t, 3> out;
+                hsv_convert::hsv_to_rgb_pixel(in[0], in[1], in[2], out[0], out[1], out[2]);
+                compare(to_rgb, reference::hsv_to_rgb(in), out);
+                hsv_convert::rgb_to_hsv_pixel(in[0], in[1], in[2], out[0], out[1], out[2]);
+                compare(to_hsv, reference::rgb_to_hsv(in), out);
+            }
+        }
+    }
+    std::printf("hsv_to_rgb: %ld of %ld inputs differ, max %d LSB\n", to_rgb.differing, to_rgb.inputs, to_rgb.max_diff);
+    std::printf("rgb_to_hsv: %ld of %ld inputs differ, max %d LSB\n", to_hsv.differing, to_hsv.inputs, to_hsv.max_diff);
+    bool passed = to_rgb.max_diff <= 1 && to_hsv.max_diff <= 1;
+    std::printf("%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
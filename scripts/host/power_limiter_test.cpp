@@ -0,0 +1,80 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: power_limiter_test.cpp
+// Host test of PowerLimiter: the current estimate and the scale that brings a frame into the budget,
+// with the level sums LedStrip collects in its output pass. Built and run by scripts/host_test.sh
+#include "../../src/Interfaces/Hardware/LedStrip/PowerLimiter/PowerLimiter.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+static int failures = 0;
+
+static void check(bool condition, const char* what, long value) {
+    std::printf("%s %s (%ld)\n", condition ? "ok  " : "FAIL", what, value);
+    if (!condition) failures++;
+}
+
+// 8.8 level sums of pixels LEDs all at the same 8 bit level
+static std::array<uint32_t, 3> uniform(uint8_t r, uint8_t g, uint8_t b, uint16_t pixels) {
+    return {static_cast<uint32_t>(r << 8) * pixels, static_cast<uint32_t>(g << 8) * pixels,
+            static_cast<uint32_t>(b << 8) * pixels};
+}
+
+int main() {
+    const uint16_t pixels = 600;
+    // WS2812B-ish: 20 mA per channel at full level, 1 mA idle per LED
+    PowerLimiter limiter({20, 20, 20}, 1);
+
+    std::array<uint32_t, 3> white = uniform(255, 255, 255, pixels);
+    check(limiter.estimate_ma(white, pixels) == 600 + 3 * 20 * 600, "full white is idle + 3 full channels",
+          limiter.estimate_ma(white, pixels));
+    check(limiter.estimate_ma(uniform(0, 0, 0, pixels), pixels) == 600, "black draws only idle",
+          limiter.estimate_ma(uniform(0, 0, 0, pixels), pixels));
+    long half_red = limiter.estimate_ma(uniform(128, 0, 0, pixels), pixels);
+    check(std::labs(half_red - (600 + 20 * 600 * 128 / 255)) <= 1, "current is linear in the level", half_red);
+
+    // no budget: full output, nothing limited
+    check(limiter.limit_scale_q16(white, pixels) == PowerLimiter::SCALE_ONE, "0 disables the limit",
+          limiter.limit_scale_q16(white, pixels));
+    check(limiter.get_limited_frames() == 0, "unlimited frames are not counted", limiter.get_limited_frames());
+
+    // 6 A budget for a 36.6 A frame: the scaled levels land on the budget, the idle draw is not scaled
+    limiter.set_budget_ma(6000);
+    uint32_t scale = limiter.limit_scale_q16(white, pixels);
+    std::array<uint32_t, 3> scaled;
+    for (size_t i = 0; i < 3; i++) scaled[i] = PowerLimiter::apply(255 << 8, scale) * static_cast<uint32_t>(pixels);
+    long scaled_ma = limiter.estimate_ma(scaled, pixels);
+    check(scaled_ma <= 6000 && scaled_ma >= 6000 - 6000 / 100, "scaled frame lands on the budget", scaled_ma);
+    check(std::labs(static_cast<long>(limiter.get_limited_ma()) - 6000) <= 1, "limited estimate is the budget",
+          limiter.get_limited_ma());
+    check(limiter.get_estimated_ma() == 36600, "estimate before the limit is kept", limiter.get_estimated_ma());
+    check(limiter.get_limited_frames() == 1, "limited frames are counted", limiter.get_limited_frames());
+
+    // a frame within the budget is left alone
+    uint32_t within = limiter.limit_scale_q16(uniform(10, 10, 10, pixels), pixels);
+    check(within == PowerLimiter::SCALE_ONE, "frame within the budget is not scaled", within);
+
+    // a budget below the idle draw turns the strip dark instead of dividing by the idle draw
+    limiter.set_budget_ma(500);
+    uint32_t dark = limiter.limit_scale_q16(white, pixels);
+    check(dark == 0, "budget under idle turns the strip dark", dark);
+    check(limiter.get_limited_ma() == 600, "dark strip still draws idle", limiter.get_limited_ma());
+
+    check(PowerLimiter::apply(255 << 8, PowerLimiter::SCALE_ONE) == 255 << 8, "full scale keeps the level",
+          PowerLimiter::apply(255 << 8, PowerLimiter::SCALE_ONE));
+    check(PowerLimiter::apply(255 << 8, PowerLimiter::SCALE_ONE / 2) == (255 << 8) / 2, "half scale halves the level",
+          PowerLimiter::apply(255 << 8, PowerLimiter::SCALE_ONE / 2));
+
+    std::printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,30 @@
+#!/bin/sh
+# host_test.sh — builds and runs the plain C++ tests in scripts/host on the desktop
+# Usage: ./host_test.sh [CXX]
+# The firmware itself needs arduino-cli (see compile.sh); these cover the parts that do not touch the hardware.
+# Built with UBSan, so an overflow or a division by zero fails the run.
+
+set -e
+CXX="${1:-${CXX:-c++}}"
+HERE="$(cd "$(dirname "$0")" && pwd)"
+SRC="$HERE/../src"
+OUT="${TMPDIR:-/tmp}/xewe_host_tests"
+mkdir -p "$OUT"
+
+"$CXX" -std=c++17 -O1 -g -fsanitize=undefined -fno-sanitize-recover -Wall -Wextra -o "$OUT/current_limiter_test" \
+    "$HERE/host/current_limiter_test.cpp" \
+    "$SRC/Interfaces/Hardware/LedStrip/CurrentSense/CurrentLimiter.cpp"
+"$OUT/current_limiter_test"
+
+"$CXX" -std=c++17 -O1 -g -fsanitize=undefined -fno-sanitize-recover -Wall -Wextra -o "$OUT/hsv_convert_test" "$HERE/host/hsv_convert_test.cpp"
+"$OUT/hsv_convert_test"
+
+"$CXX" -std=c++17 -O1 -g -fsanitize=undefined -fno-sanitize-recover -Wall -Wextra -o "$OUT/power_limiter_test" \
+    "$HERE/host/power_limiter_test.cpp" \
+    "$SRC/Interfaces/Hardware/LedStrip/PowerLimiter/PowerLimiter.cpp"
+"$OUT/power_limiter_test"
+
+"$CXX" -std=c++17 -O1 -g -fsanitize=undefined -fno-sanitize-recover -Wall -Wextra -pthread -o "$OUT/frame_stats_test" \
+    "$HERE/host/frame_stats_test.cpp" \
+    "$SRC/Interfaces/Hardware/LedStrip/FrameStats/FrameStats.cpp"
+"$OUT/frame_stats_test"
@@ -0,0 +1,118 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// AllocationCounter.cpp
+#include "AllocationCounter.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<uint32_t> allocations{0};
+    // the task a TaskAllocationScope watches and its allocations since the scope began
+    std::atomic<TaskHandle_t> watched_task{nullptr};
+    std::atomic<uint32_t> watched_allocations{0};
+
+    void count_allocation() noexcept {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        TaskHandle_t watched = watched_task.load(std::memory_order_relaxed);
+        if (watched && watched == xTaskGetCurrentTaskHandle()) {
+            watched_allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // the new handler may free memory and is asked again, without one the throwing forms fail like the
+    // library default (bad_alloc, abort without exceptions)
+    // aligned_alloc wants the size in whole alignments, 0 means the plain malloc alignment will do
+    void* raw_alloc(std::size_t size, std::size_t alignment) noexcept {
+        if (size == 0) size = 1;
+        if (!alignment) return std::malloc(size);
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    }
+
+    void* allocate_or_fail(std::size_t size, std::size_t alignment = 0) {
+        count_allocation();
+        for (;;) {
+            void* ptr = raw_alloc(size, alignment);
+            if (ptr) return ptr;
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) break;
+            handler();
+        }
+#if defined(__cpp_exceptions)
+        throw std::bad_alloc();
+#else
+        std::abort();
+#endif
+    }
+
+    void* allocate_or_null(std::size_t size, std::size_t alignment = 0) noexcept {
+        count_allocation();
+        return raw_alloc(size, alignment);
+    }
+}
+
+uint32_t allocation_count() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+TaskAllocationScope::TaskAllocationScope() {
+    TaskHandle_t expected = nullptr;
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    exclusive = self && watched_task.compare_exchange_strong(expected, self, std::memory_order_relaxed);
+    if (exclusive) watched_allocations.store(0, std::memory_order_relaxed);
+    allocations_before = allocation_count();
+}
+
+TaskAllocationScope::~TaskAllocationScope() {
+    if (exclusive) watched_task.store(nullptr, std::memory_order_relaxed);
+}
+
+uint32_t TaskAllocationScope::count() const {
+    return exclusive ? watched_allocations.load(std::memory_order_relaxed) : allocation_count() - allocations_before;
+}
+
+// every form is replaced, so each allocation is counted once and the nothrow forms really return nullptr.
+// the default operator delete, aligned or not, frees with free(), which matches malloc and aligned_alloc here
+void* operator new(std::size_t size) {
+    return allocate_or_fail(size);
+}
+
+void* operator new[](std::size_t size) {
+    return allocate_or_fail(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate_or_null(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate_or_null(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocate_or_fail(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocate_or_fail(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_or_null(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_or_null(size, static_cast<std::size_t>(alignment));
+}
@@ -0,0 +1,37 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// AllocationCounter.h
+#pragma once
+
+#include <cstdint>
+
+// Counts every call to the global operator new: plain, array, nothrow and the aligned forms of each
+// (the replacements live in AllocationCounter.cpp).
+// Cheap enough to stay on in release builds
+uint32_t allocation_count();
+
+// Counts the allocations of the task that opened it until it closes, to prove a code path does not touch
+// the heap while wifi or the web server allocate on other tasks. One task is watched at a time: a scope
+// opened while another task holds the watch falls back to the system wide count, an upper bound
+class TaskAllocationScope {
+public:
+                    TaskAllocationScope     ();
+                    ~TaskAllocationScope    ();
+                    TaskAllocationScope     (const TaskAllocationScope&) = delete;
+    TaskAllocationScope& operator=          (const TaskAllocationScope&) = delete;
+
+    uint32_t        count                   () const;
+
+private:
+    bool            exclusive               = false;
+    uint32_t        allocations_before      = 0;
+};
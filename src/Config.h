@@ -15,4 +15,68 @@
 #define LED_STRIP_TYPE              WS2815
 #define LED_STRIP_COLOR_ORDER       RGB
 #define LED_STRIP_NUM_LEDS_MAX      600
+#define LED_STRIP_SEGMENTS_MAX      8
+#define LED_STRIP_PALETTES_MAX      8
+
+// Output correction, baked into per-channel lookup tables at compile time.
+// Gamma is x100 (220 = 2.2, 100 = linear), white balance is the channel scale at full level.
+// WS281x defaults: gamma 2.2, white balance FF B0 F0 (FastLED TypicalLEDStrip)
+#define LED_STRIP_GAMMA_R           220
+#define LED_STRIP_GAMMA_G           220
+#define LED_STRIP_GAMMA_B           220
+#define LED_STRIP_WHITE_BALANCE_R   255
+#define LED_STRIP_WHITE_BALANCE_G   176
+#define LED_STRIP_WHITE_BALANCE_B   240
+
+// Temporal dithering of the 8.8 fixed point output, smooths long fades at low brightness.
+// 0 keeps the plain 8 bit output and lets unchanged solid frames be skipped
+#define LED_STRIP_DITHER            1
+
+// Frame rate: the frame interval follows the wire time of the strip (24 bits per LED at LED_STRIP_BIT_NS
+// plus the LED_STRIP_RESET_US latch) and keeps LED_STRIP_FRAME_HEADROOM percent of it for the rest of
+// the system, never faster than LED_STRIP_FPS_MAX. WS2815: 800 kHz data, 280 us reset
+#define LED_STRIP_BIT_NS            1250
+#define LED_STRIP_RESET_US          280
+#define LED_STRIP_FRAME_HEADROOM    25
+#define LED_STRIP_FPS_MAX           120
+
+// Power limiting: current of one channel at full level and the idle current of one LED, in mA.
+// The budget caps the estimated strip current, 0 = unlimited; "$led power_budget" changes it at runtime
+#define LED_STRIP_CHANNEL_MA_R      15
+#define LED_STRIP_CHANNEL_MA_G      15
+#define LED_STRIP_CHANNEL_MA_B      15
+#define LED_STRIP_IDLE_MA           1
+#define LED_STRIP_POWER_BUDGET_MA   0
+
+// Strip current sense on the dock ADC pin (see ConfigDock.h), uncomment to correct the estimated power limit
+// with the measured current. The sense amplifier outputs LED_STRIP_ISENSE_MV_PER_A mV per A above
+// LED_STRIP_ISENSE_OFFSET_MV; the ADC averages LED_STRIP_ISENSE_AVERAGE conversions into one reading.
+// The idle draw behind the sense resistor, LED_STRIP_ISENSE_BASE_MA plus LED_STRIP_IDLE_MA per LED, is not trimmed
+//#define PIN_STRIP_ISENSE            5
+#define LED_STRIP_ISENSE_MV_PER_A   100
+#define LED_STRIP_ISENSE_OFFSET_MV  0
+#define LED_STRIP_ISENSE_SAMPLE_HZ  20000
+#define LED_STRIP_ISENSE_AVERAGE    100
+#define LED_STRIP_ISENSE_BASE_MA    0
+
+// Idle: a static frame (solid color, no transition) parks the render task until the next change,
+// it still wakes every LED_STRIP_IDLE_WAKE_MS. The system loop then yields SYSTEM_IDLE_LOOP_MS per pass.
+// LED_STRIP_SUPPLY_MV turns the strip current into the LED power shown by "$system status" (the strip
+// only, the controller is not measured). The CPU load there needs CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS.
+// SYSTEM_POWER_SAVE 1 lets the CPU scale its clock and enter light sleep between ticks
+// (needs CONFIG_PM_ENABLE and tickless idle in the sdkconfig)
+#define LED_STRIP_IDLE_WAKE_MS      1000
+#define LED_STRIP_SUPPLY_MV         12000
+#define SYSTEM_IDLE_LOOP_MS         10
+#define SYSTEM_POWER_SAVE           0
+
+// Frame stats: per stage frame time histograms for "$led stats" and the web /stats endpoint,
+// 0 compiles the timing probes out
+#define LED_STRIP_FRAME_STATS       1
+
+// Extra output pins, uncomment to split the strip into parallel channels.
+// Each channel drives an equal slice of the LEDs, channels are clocked out concurrently.
+//#define PIN_LED_STRIP_2             1
+//#define PIN_LED_STRIP_3             2
+//#define PIN_LED_STRIP_4             3
 
@@ -32,7 +32,7 @@
 
 // LedController & friends
 #define DEBUG_AsyncTimer        0
-#define DEBUG_AsyncTimerArray   0
+#define DEBUG_Transition        0
 #define DEBUG_Brightness        0
 #define DEBUG_PerlinFade        0
 #define DEBUG_ColorSolid        0
@@ -40,6 +40,10 @@
 #define DEBUG_ColorChanging     0
 #define DEBUG_LedMode           0
 #define DEBUG_LedStrip          0
+#define DEBUG_Segment           0
+#define DEBUG_Palette           0
+#define DEBUG_PaletteFlow       0
+#define DEBUG_CurrentSense      0
 
 // SystemController
 #define DEBUG_CommandParser     0
@@ -9,11 +9,11 @@
  *********************************************************************************/
 
 
-
 #ifndef ASYNCTIMER_H
 #define ASYNCTIMER_H
 
 #include "../../../../Debug.h"
+#include "ProgressClock.h"
 
 template<typename T>
 class AsyncTimer {
@@ -21,59 +21,22 @@ class AsyncTimer {
                   "AsyncTimer<T> requires an arithmetic type");
 
 private:
-    mutable uint32_t start_time{};
-    mutable uint32_t last_calc_time{};
-    static constexpr uint32_t calc_interval_ms = 5;
-
-    uint32_t delay_ms;
+    ProgressClock clock;
     T start_val, target_val;
-
-    mutable bool done{false}, initiated{false};
-    mutable double progress{0.0};
-
-    void calculate_progress() const {
-        // This is a frequently called helper, extensive logging is not advised.
-        // DBG_PRINTLN(AsyncTimer, "-> AsyncTimer::calculate_progress()");
-        if (done || !initiated) return;
-
-        uint32_t now = millis();
-        // Throttle: skip if we ran less than calc_interval_ms ago
-        if (now - last_calc_time < calc_interval_ms) return;
-        last_calc_time = now;
-
-        if (start_val == target_val) {
-            done = true;
-            progress = 1.0;
-            return;
-        }
-
-        uint32_t elapsed = now - start_time;
-        progress = double(elapsed) / delay_ms;
-        if (progress >= 1.0) {
-            done = true;
-            progress = 1.0;
-        }
-        // DBG_PRINTLN(AsyncTimer, "<- AsyncTimer::calculate_progress()");
-    }
+    Easing easing;
 
 public:
-    AsyncTimer(uint32_t delay, T start = T(), T target = T())
-        : delay_ms(delay), start_val(start), target_val(target) {
-        DBG_PRINTF(AsyncTimer, "-> AsyncTimer::AsyncTimer(delay: %lu, start: %f, target: %f)\n", delay, static_cast<double>(start), static_cast<double>(target));
+    AsyncTimer(uint32_t delay, T start = T(), T target = T(), Easing easing = Easing::LINEAR)
+        : clock(delay), start_val(start), target_val(target), easing(easing) {
+        DBG_PRINTF(AsyncTimer, "-> AsyncTimer::AsyncTimer(delay: %lu, start: %f, target: %f, easing: %s)\n", delay, static_cast<double>(start), static_cast<double>(target), easing_name(easing));
         DBG_PRINTLN(AsyncTimer, "<- AsyncTimer::AsyncTimer()");
     }
     ~AsyncTimer() = default;
 
     void initiate() {
         DBG_PRINTLN(AsyncTimer, "-> AsyncTimer::initiate()");
-        start_time = millis();
-        if (start_time > calc_interval_ms)
-            last_calc_time = start_time - calc_interval_ms;
-        else
-            last_calc_time = 0;
-        progress = 0.0;
-        done = false;
-        initiated = true;
+        clock.initiate();
+        if (start_val == target_val) clock.finish();
         DBG_PRINTLN(AsyncTimer, "<- AsyncTimer::initiate()");
     }
 
@@ -85,45 +48,55 @@ public:
 
     T get_current_value() const {
         DBG_PRINTLN(AsyncTimer, "-> AsyncTimer::get_current_value()");
-        calculate_progress();
-        T result = done ? target_val : T(start_val + (target_val - start_val) * progress);
+        uint32_t weight = ease_q16(easing, clock.progress_q16(), target_val < start_val);
+        T result = lerp_q16(start_val, target_val, weight);
         DBG_PRINTF(AsyncTimer, "<- AsyncTimer::get_current_value() returns: %f\n", static_cast<double>(result));
         return result;
     }
 
+    // current value * 256, keeping the 8 fraction bits get_current_value() rounds away. integral T only
+    int32_t get_current_value_q8() const {
+        static_assert(std::is_integral_v<T>, "get_current_value_q8 needs an integral T");
+        uint32_t weight = ease_q16(easing, clock.progress_q16(), target_val < start_val);
+        if (weight >= Q16_ONE) return static_cast<int32_t>(target_val) * 256;
+        int64_t diff = static_cast<int64_t>(target_val) - static_cast<int64_t>(start_val);
+        return static_cast<int32_t>(static_cast<int64_t>(start_val) * 256
+                                    + ((diff * weight * 256 + (Q16_ONE >> 1)) >> 16));
+    }
+
     T get_target_value() const {
         DBG_PRINTLN(AsyncTimer, "-> AsyncTimer::get_target_value()");
         DBG_PRINTF(AsyncTimer, "<- AsyncTimer::get_target_value() returns: %f\n", static_cast<double>(target_val));
         return target_val;
     }
 
+    Easing get_easing() const { return easing; }
+
+    void set_easing(Easing new_easing) { easing = new_easing; }
+
     bool is_done() const {
         DBG_PRINTLN(AsyncTimer, "-> AsyncTimer::is_done()");
-        calculate_progress();
-        DBG_PRINTF(AsyncTimer, "<- AsyncTimer::is_done() returns: %s\n", done ? "true" : "false");
-        return done;
+        bool result = clock.is_done();
+        DBG_PRINTF(AsyncTimer, "<- AsyncTimer::is_done() returns: %s\n", result ? "true" : "false");
+        return result;
     }
 
     bool is_active() const {
         DBG_PRINTLN(AsyncTimer, "-> AsyncTimer::is_active()");
-        calculate_progress();
-        bool result = initiated && !done;
+        bool result = clock.is_initiated() && !clock.is_done();
         DBG_PRINTF(AsyncTimer, "<- AsyncTimer::is_active() returns: %s\n", result ? "true" : "false");
         return result;
     }
 
     void terminate() {
         DBG_PRINTLN(AsyncTimer, "-> AsyncTimer::terminate()");
-        initiated = false;
+        clock.terminate();
         DBG_PRINTLN(AsyncTimer, "<- AsyncTimer::terminate()");
     }
 
     void reset() {
         DBG_PRINTLN(AsyncTimer, "-> AsyncTimer::reset()");
-        done = false;
-        progress = 0.0;
-        initiated = false;
-        last_calc_time = 0;
+        clock.reset();
         DBG_PRINTLN(AsyncTimer, "<- AsyncTimer::reset()");
     }
 
@@ -137,7 +110,7 @@ public:
 
     void reset(uint32_t new_delay, T new_start, T new_target) {
         DBG_PRINTF(AsyncTimer, "-> AsyncTimer::reset(new_delay: %lu, new_start: %f, new_target: %f)\n", new_delay, static_cast<double>(new_start), static_cast<double>(new_target));
-        delay_ms = new_delay;
+        clock.set_duration(new_delay);
         start_val = new_start;
         target_val = new_target;
         reset();
@@ -0,0 +1,99 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+#ifndef EASING_H
+#define EASING_H
+
+#include <cstdint>
+#include <array>
+
+// Progress and eased weights are Q16: 0 is the start, Q16_ONE is the target.
+constexpr uint32_t Q16_ONE = 1u << 16;
+
+enum class Easing : uint8_t {
+    LINEAR      = 0,
+    EASE_IN     = 1,    // quadratic, slow start
+    EASE_OUT    = 2,    // quadratic, slow end
+    EASE_IN_OUT = 3,    // smoothstep
+    CUBIC       = 4,    // cubic ease in-out, sharper middle than smoothstep
+    PERCEPTUAL  = 5,    // steps look even to the eye (CIE 1931 lightness), meant for brightness
+};
+
+namespace easing_detail {
+    // inverse CIE lightness: relative luminance for L* = 0, 100/32, ..., 100, in Q16.
+    // built at compile time, only the integer table ends up in flash
+    constexpr std::array<uint32_t, 33> make_lightness_table() {
+        std::array<uint32_t, 33> table{};
+        for (int i = 0; i <= 32; i++) {
+            double l = 100.0 * i / 32;
+            double y = l > 8.0 ? ((l + 16.0) / 116.0) * ((l + 16.0) / 116.0) * ((l + 16.0) / 116.0) : l / 903.3;
+            table[i] = static_cast<uint32_t>(y * Q16_ONE + 0.5);
+        }
+        return table;
+    }
+
+    constexpr std::array<uint32_t, 33> LIGHTNESS_TABLE = make_lightness_table();
+
+    constexpr uint32_t mul_q16(uint32_t a, uint32_t b) {
+        return static_cast<uint32_t>((static_cast<uint64_t>(a) * b) >> 16);
+    }
+
+    constexpr uint32_t lightness_to_luminance(uint32_t p) {
+        uint32_t index = p >> 11;                  // 32 segments of 2048
+        if (index >= 32) return LIGHTNESS_TABLE[32];
+        uint32_t fraction = p & 0x7FF;
+        uint32_t low = LIGHTNESS_TABLE[index], high = LIGHTNESS_TABLE[index + 1];
+        return low + (((high - low) * fraction) >> 11);
+    }
+}
+
+// Maps linear progress to an eased weight, both Q16 in [0, Q16_ONE].
+// PERCEPTUAL is direction aware: a fade towards a lower value mirrors the curve so
+// fading out is perceived as even as fading in.
+constexpr uint32_t ease_q16(Easing easing, uint32_t p, bool descending = false) {
+    using namespace easing_detail;
+    if (p >= Q16_ONE) return Q16_ONE;
+    switch (easing) {
+        case Easing::EASE_IN:
+            return mul_q16(p, p);
+        case Easing::EASE_OUT: {
+            uint32_t rest = Q16_ONE - p;
+            return Q16_ONE - mul_q16(rest, rest);
+        }
+        case Easing::EASE_IN_OUT:
+            return static_cast<uint32_t>((static_cast<uint64_t>(p) * p * (3 * Q16_ONE - 2 * p)) >> 32);
+        case Easing::CUBIC: {
+            // products stay within 2^50, a single shift keeps the curve monotonic
+            if (p < Q16_ONE / 2) return static_cast<uint32_t>((static_cast<uint64_t>(p) * p * p) >> 30);
+            uint64_t rest = Q16_ONE - p;
+            return Q16_ONE - static_cast<uint32_t>((rest * rest * rest) >> 30);
+        }
+        case Easing::PERCEPTUAL:
+            return descending ? Q16_ONE - lightness_to_luminance(Q16_ONE - p) : lightness_to_luminance(p);
+        case Easing::LINEAR:
+        default:
+            return p;
+    }
+}
+
+inline const char* easing_name(Easing easing) {
+    switch (easing) {
+        case Easing::EASE_IN:     return "Ease In";
+        case Easing::EASE_OUT:    return "Ease Out";
+        case Easing::EASE_IN_OUT: return "Ease In Out";
+        case Easing::CUBIC:       return "Cubic";
+        case Easing::PERCEPTUAL:  return "Perceptual";
+        case Easing::LINEAR:
+        default:                  return "Linear";
+    }
+}
+
+#endif  // EASING_H
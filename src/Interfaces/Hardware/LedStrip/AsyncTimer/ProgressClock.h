@@ -0,0 +1,91 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+#ifndef PROGRESSCLOCK_H
+#define PROGRESSCLOCK_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <algorithm>
+#include <type_traits>
+#include "Easing.h"
+
+// Integer timer core shared by AsyncTimer and Transition.
+// Progress comes straight from the 64-bit esp_timer clock as Q16, no float and no update throttling:
+// the per-call cost is one subtraction, one shift and one 32x32->64 multiply.
+// Any uint32_t duration in ms works (up to ~49.7 days, e.g. an hour long sunrise fade): elapsed time and
+// duration are shifted down to 16 bits first, which is all the resolution Q16 progress has anyway
+class ProgressClock {
+public:
+    explicit ProgressClock(uint32_t duration_ms) { set_duration(duration_ms); }
+
+    void set_duration(uint32_t duration_ms) {
+        duration_us = static_cast<uint64_t>(duration_ms) * 1000;
+        shift = 0;
+        while ((duration_us >> shift) > UINT16_MAX) shift++;
+        // 2^32 / duration, so progress = elapsed * rate >> 16 needs no division per call
+        uint64_t scaled = duration_us >> shift;
+        rate = scaled ? static_cast<uint32_t>(std::min<uint64_t>((uint64_t(1) << 32) / scaled, UINT32_MAX)) : 0;
+    }
+
+    void initiate() {
+        start_us  = now_us();
+        done      = false;
+        initiated = true;
+    }
+
+    void finish()    { done = true; }
+    void terminate() { initiated = false; }
+    void reset()     { done = false; initiated = false; }
+
+    bool is_initiated() const { return initiated; }
+
+    bool is_done() const {
+        if (!done && initiated && now_us() - start_us >= duration_us) done = true;
+        return done;
+    }
+
+    uint32_t progress_q16() const {
+        if (!initiated) return 0;
+        if (is_done()) return Q16_ONE;
+        // clamped to the duration, so the shifted value fits 16 bits
+        uint32_t elapsed = static_cast<uint32_t>(std::min(now_us() - start_us, duration_us) >> shift);
+        return static_cast<uint32_t>((static_cast<uint64_t>(elapsed) * rate) >> 16);
+    }
+
+private:
+    static uint64_t now_us() { return static_cast<uint64_t>(esp_timer_get_time()); }
+
+    uint64_t                start_us        = 0;
+    uint64_t                duration_us     = 0;
+    uint32_t                rate            = 0;
+    uint8_t                 shift           = 0;
+    mutable bool            done            = false;
+    bool                    initiated       = false;
+};
+
+// start + (target - start) * weight, weight in Q16, rounded to nearest for integer types
+template<typename T>
+T lerp_q16(T start, T target, uint32_t weight) {
+    if (weight >= Q16_ONE) return target;
+    if constexpr (std::is_floating_point_v<T>) {
+        return start + (target - start) * (static_cast<T>(weight) / Q16_ONE);
+    } else if constexpr (sizeof(T) == 1) {
+        // 8-bit values fit the 32-bit path, the common case for colors and brightness
+        int32_t diff = static_cast<int32_t>(target) - static_cast<int32_t>(start);
+        return static_cast<T>(static_cast<int32_t>(start) + ((diff * static_cast<int32_t>(weight) + static_cast<int32_t>(Q16_ONE >> 1)) >> 16));
+    } else {
+        int64_t diff = static_cast<int64_t>(target) - static_cast<int64_t>(start);
+        return static_cast<T>(static_cast<int64_t>(start) + ((diff * weight + (Q16_ONE >> 1)) >> 16));
+    }
+}
+
+#endif  // PROGRESSCLOCK_H
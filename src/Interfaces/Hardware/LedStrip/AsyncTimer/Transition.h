@@ -0,0 +1,116 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+#ifndef TRANSITION_H
+#define TRANSITION_H
+
+#include <array>
+#include <cstddef>
+#include "../../../../Debug.h"
+#include "ProgressClock.h"
+
+// Interpolates N channels of T from start to target over a fixed duration
+// (RGB, RGBW, 16-bit colors, segment or palette positions, ...).
+// get_current_value() reads the clock and evaluates the curve once, then runs one
+// branch-free loop over the channels.
+template<typename T, size_t N>
+class Transition {
+    static_assert(std::is_arithmetic_v<T>,
+                  "Transition<T, N> requires an arithmetic type");
+    static_assert(N > 0, "Transition<T, N> needs at least one channel");
+
+public:
+    using Values = std::array<T, N>;
+
+    Transition(uint32_t delay, const Values& start = {}, const Values& target = {}, Easing easing = Easing::LINEAR)
+        : clock(delay), start_val(start), target_val(target), easing(easing) {
+        DBG_PRINTF(Transition, "-> Transition::Transition(delay: %lu, channels: %u, easing: %s)\n", delay, unsigned(N), easing_name(easing));
+        DBG_PRINTLN(Transition, "<- Transition::Transition()");
+    }
+    ~Transition() = default;
+
+    void initiate() {
+        DBG_PRINTLN(Transition, "-> Transition::initiate()");
+        clock.initiate();
+        if (start_val == target_val) clock.finish();
+        DBG_PRINTLN(Transition, "<- Transition::initiate()");
+    }
+
+    Values get_start_value() const { return start_val; }
+
+    Values get_target_value() const { return target_val; }
+
+    Values get_current_value() const {
+        Values current;
+        get_current_value(current);
+        return current;
+    }
+
+    void get_current_value(Values& current) const {
+        uint32_t progress = clock.progress_q16();
+        // only PERCEPTUAL depends on the direction, both weights are computed once per call
+        uint32_t weight_up   = ease_q16(easing, progress, false);
+        uint32_t weight_down = ease_q16(easing, progress, true);
+        for (size_t i = 0; i < N; ++i) {
+            current[i] = lerp_q16(start_val[i], target_val[i], target_val[i] < start_val[i] ? weight_down : weight_up);
+        }
+    }
+
+    // current values * 256, keeping the 8 fraction bits get_current_value() rounds away. 8 bit T only
+    std::array<uint16_t, N> get_current_value_q8() const {
+        static_assert(std::is_integral_v<T> && sizeof(T) == 1, "get_current_value_q8 needs an 8 bit T");
+        std::array<uint16_t, N> current;
+        uint32_t progress = clock.progress_q16();
+        uint32_t weight_up   = ease_q16(easing, progress, false);
+        uint32_t weight_down = ease_q16(easing, progress, true);
+        for (size_t i = 0; i < N; ++i) {
+            uint32_t weight = target_val[i] < start_val[i] ? weight_down : weight_up;
+            if (weight >= Q16_ONE) weight = Q16_ONE;
+            int32_t diff = static_cast<int32_t>(target_val[i]) - static_cast<int32_t>(start_val[i]);
+            current[i] = static_cast<uint16_t>(static_cast<int32_t>(start_val[i]) * 256
+                                               + ((diff * static_cast<int32_t>(weight) + 128) >> 8));
+        }
+        return current;
+    }
+
+    Easing get_easing() const { return easing; }
+
+    void set_easing(Easing new_easing) { easing = new_easing; }
+
+    bool is_done() const { return clock.is_done(); }
+
+    bool is_active() const { return clock.is_initiated() && !clock.is_done(); }
+
+    /** Stop without completing (keeps current state). */
+    void terminate() { clock.terminate(); }
+
+    /** Reset to un-initiated state (will recalc on next initiate). */
+    void reset() { clock.reset(); }
+
+    void reset(const Values& new_start, const Values& new_target) {
+        start_val  = new_start;
+        target_val = new_target;
+        reset();
+    }
+
+    void reset(uint32_t new_delay, const Values& new_start, const Values& new_target) {
+        clock.set_duration(new_delay);
+        reset(new_start, new_target);
+    }
+
+private:
+    ProgressClock   clock;
+    Values          start_val;
+    Values          target_val;
+    Easing          easing;
+};
+
+#endif  // TRANSITION_H
@@ -12,7 +12,7 @@
 
 #include "Brightness.h"
 
-Brightness::Brightness(uint16_t transition_delay, uint8_t initial_brightness, uint8_t state_param) // Renamed 'state' parameter to 'state_param' to avoid conflict with member 'state'
+Brightness::Brightness(uint16_t transition_delay, uint8_t initial_brightness, uint8_t state_param, Easing easing) // Renamed 'state' parameter to 'state_param' to avoid conflict with member 'state'
     : state(state_param), last_brightness(initial_brightness)
 {
     DBG_PRINTF(Brightness, "-> Brightness::Brightness(delay=%u, initial_brightness=%u, state=%u)\n",
@@ -30,11 +30,11 @@ Brightness::Brightness(uint16_t transition_delay, uint8_t initial_brightness, ui
     // construction and are safe before the object is usable by other threads.
     // No explicit mutex lock needed here for these initial assignments.
     if (this->state) { // Use this->state
-        timer = std::make_unique<AsyncTimer<uint8_t>>(transition_delay, last_brightness, initial_brightness);
+        timer = std::make_unique<AsyncTimer<uint8_t>>(transition_delay, last_brightness, initial_brightness, easing);
         DBG_PRINTF(Brightness, "  Created timer for ON state: start=%u, target=%u\n",
                    last_brightness, initial_brightness);
     } else {
-        timer = std::make_unique<AsyncTimer<uint8_t>>(transition_delay, 0, 0);
+        timer = std::make_unique<AsyncTimer<uint8_t>>(transition_delay, 0, 0, easing);
         DBG_PRINTLN(Brightness, "  Created timer for OFF state: start=0, target=0");
     }
 
@@ -254,6 +254,19 @@ std::array<uint8_t,3> Brightness::get_dimmed_color (std::array<uint8_t,3> color_
     return result;
 }
 
+BrightnessFrame Brightness::get_frame() const {
+    // one lock and one timer read per frame; the caller scales every pixel with the snapshot
+    uint16_t level_q8 = 0;
+    if (xSemaphoreTake(const_cast<Brightness*>(this)->internal_mutex, portMAX_DELAY) == pdTRUE) {
+        bool timer_is_done = timer->is_done();
+        level_q8 = (!state && timer_is_done) ? 0 : timer->get_current_value_q8();
+        xSemaphoreGive(const_cast<Brightness*>(this)->internal_mutex);
+    } else {
+        DBG_PRINTLN(Brightness, "ERROR: Could not take internal_mutex in get_frame");
+    }
+    return BrightnessFrame::from_level_q8(level_q8);
+}
+
 bool Brightness::get_state() const {
     DBG_PRINTLN(Brightness, "-> Brightness::get_state()");
     bool s = false; // Default value
@@ -267,6 +280,17 @@ bool Brightness::get_state() const {
     return s;
 }
 
+bool Brightness::is_transitioning() const {
+    bool active = false;
+    if (xSemaphoreTake(const_cast<Brightness*>(this)->internal_mutex, portMAX_DELAY) == pdTRUE) {
+        active = timer->is_active();
+        xSemaphoreGive(const_cast<Brightness*>(this)->internal_mutex);
+    } else {
+        DBG_PRINTLN(Brightness, "ERROR: Could not take internal_mutex in is_transitioning");
+    }
+    return active;
+}
+
 uint8_t Brightness::get_last_brightness() const {
     DBG_PRINTLN(Brightness, "-> Brightness::get_last_brightness()");
     uint8_t lb = 0; // Default value
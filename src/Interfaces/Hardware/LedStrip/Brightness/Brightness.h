@@ -13,16 +13,46 @@
 #ifndef BRIGHTNESS_H
 #define BRIGHTNESS_H
 
+#include <algorithm>
 #include <memory>
+#include <array>
 #include "../../../../Debug.h"
 #include "../AsyncTimer/AsyncTimer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 
+// Immutable brightness snapshot taken once per frame.
+// apply() is exact floor(color * scale / 255) using a fixed-point multiplier,
+// so a whole frame can be scaled without touching the mutex or the timer.
+struct BrightnessFrame {
+    uint8_t         scale                   = 255;
+    uint16_t        multiplier              = 255 * 257;
+    // level_q8 * 65536 / 255: the same brightness with the 8 fraction bits kept from the transition
+    uint32_t        multiplier_q8           = 255u * 65793u;
+
+    static BrightnessFrame  from_scale      (uint8_t scale)         { return {scale, static_cast<uint16_t>(scale * 257), scale * 65793u}; }
+    static BrightnessFrame  from_level_q8   (uint16_t level_q8) {
+        uint8_t rounded = static_cast<uint8_t>(std::min<uint32_t>((level_q8 + 128u) >> 8, 255));
+        return {rounded, static_cast<uint16_t>(rounded * 257), level_q8 * 257u + (level_q8 >> 8)};
+    }
+    uint8_t         apply                   (uint8_t color) const   { return static_cast<uint8_t>((static_cast<uint32_t>(color) * multiplier + 257) >> 16); }
+    // color_q8 * brightness / 255 with both in 8.8 fixed point, rounded once; exact color_q8 at full brightness
+    uint16_t        apply_q8                (uint16_t color_q8) const {
+        return static_cast<uint16_t>((static_cast<uint64_t>(color_q8) * multiplier_q8 + 0x800000u) >> 24);
+    }
+    // both brightness levels in one frame, used where a pass applies a single brightness per pixel
+    BrightnessFrame combined                (const BrightnessFrame& other) const {
+        uint32_t q8 = static_cast<uint32_t>((static_cast<uint64_t>(multiplier_q8) * other.multiplier_q8 + 0x800000u) >> 24);
+        uint8_t rounded = static_cast<uint8_t>((static_cast<uint32_t>(scale) * other.scale + 127) / 255);
+        return {rounded, static_cast<uint16_t>(rounded * 257), q8};
+    }
+};
+
 class Brightness {
 
 public:
-    Brightness                              (uint16_t transition_delay, uint8_t initial_brightness, uint8_t state);
+    Brightness                              (uint16_t transition_delay, uint8_t initial_brightness, uint8_t state,
+                                             Easing easing = Easing::LINEAR);
     ~Brightness                             ();
 
     uint8_t         get_start_value         () const;
@@ -33,7 +63,9 @@ public:
     void            turn_off                ();
     uint8_t         get_dimmed_color        (uint8_t color) const;
     std::array<uint8_t,3>         get_dimmed_color        (std::array<uint8_t,3> color_rgb) const;
+    BrightnessFrame get_frame               () const;
     bool            get_state               () const;
+    bool            is_transitioning        () const;
     uint8_t         get_last_brightness     () const;
 private:
     std::unique_ptr<AsyncTimer<uint8_t>>    timer;
@@ -0,0 +1,55 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: AdcCurrentSource.cpp
+#include "AdcCurrentSource.h"
+
+volatile bool AdcCurrentSource::conversion_done = false;
+
+void IRAM_ATTR AdcCurrentSource::on_conversion_done() {
+    conversion_done = true;
+}
+
+AdcCurrentSource::AdcCurrentSource(uint8_t pin, uint16_t mv_per_a, uint16_t offset_mv,
+                                   uint32_t sample_hz, uint16_t average)
+    : pin(pin), mv_per_a(mv_per_a), offset_mv(offset_mv), sample_hz(sample_hz), average(average) {}
+
+AdcCurrentSource::~AdcCurrentSource() {
+    if (running) {
+        analogContinuousStop();
+        analogContinuousDeinit();
+    }
+}
+
+bool AdcCurrentSource::begin() {
+    DBG_PRINTF(CurrentSense, "-> AdcCurrentSource::begin(pin: %u, sample_hz: %lu, average: %u)\n", pin, sample_hz, average);
+    uint8_t pins[] = {pin};
+    analogContinuousSetWidth(12);
+    analogContinuousSetAtten(ADC_11db);
+    if (!analogContinuous(pins, 1, average, sample_hz, &AdcCurrentSource::on_conversion_done)) {
+        DBG_PRINTLN(CurrentSense, "ERROR: Could not set up continuous ADC");
+        return false;
+    }
+    running = analogContinuousStart();
+    if (!running) analogContinuousDeinit();
+    DBG_PRINTF(CurrentSense, "<- AdcCurrentSource::begin() returns: %s\n", running ? "true" : "false");
+    return running;
+}
+
+bool AdcCurrentSource::read_ma(uint32_t& current_ma) {
+    if (!running || !conversion_done) return false;
+    conversion_done = false;
+    adc_continuous_data_t* result = nullptr;
+    if (!analogContinuousRead(&result, 0) || !result) return false;
+    int sense_mv = result[0].avg_read_mvolts - offset_mv;
+    current_ma = sense_mv > 0 ? static_cast<uint32_t>(sense_mv) * 1000u / mv_per_a : 0;
+    return true;
+}
@@ -0,0 +1,44 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: AdcCurrentSource.h
+#ifndef ADCCURRENTSOURCE_H
+#define ADCCURRENTSOURCE_H
+
+#include <Arduino.h>
+#include "CurrentSource.h"
+#include "../../../../Debug.h"
+
+// Strip current from the sense amplifier on an ADC pin. The ADC runs in continuous (DMA) mode at
+// sample_hz and averages `average` conversions into one reading, so reading never blocks the render task.
+// One instance at a time: the conversion done flag is shared with the ADC interrupt
+class AdcCurrentSource : public CurrentSource {
+public:
+    AdcCurrentSource                        (uint8_t pin, uint16_t mv_per_a, uint16_t offset_mv,
+                                             uint32_t sample_hz, uint16_t average);
+    ~AdcCurrentSource                       () override;
+
+    bool            begin                   () override;
+    bool            read_ma                 (uint32_t& current_ma) override;
+
+private:
+    static void IRAM_ATTR on_conversion_done();
+    static volatile bool                    conversion_done;
+
+    uint8_t         pin;
+    uint16_t        mv_per_a;
+    uint16_t        offset_mv;
+    uint32_t        sample_hz;
+    uint16_t        average;
+    bool            running                 = false;
+};
+
+#endif  // ADCCURRENTSOURCE_H
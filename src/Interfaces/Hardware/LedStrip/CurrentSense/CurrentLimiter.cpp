@@ -0,0 +1,79 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: CurrentLimiter.cpp
+#include "CurrentLimiter.h"
+#include <algorithm>
+
+CurrentLimiter::CurrentLimiter(uint16_t budget_ma, uint16_t idle_ma) : budget_ma(budget_ma), idle_ma(idle_ma) {}
+
+void CurrentLimiter::set_budget_ma(uint16_t new_budget_ma) {
+    budget_ma.store(new_budget_ma, std::memory_order_relaxed);
+}
+
+uint16_t CurrentLimiter::get_budget_ma() const {
+    return budget_ma.load(std::memory_order_relaxed);
+}
+
+void CurrentLimiter::set_idle_ma(uint16_t new_idle_ma) {
+    idle_ma.store(new_idle_ma, std::memory_order_relaxed);
+}
+
+uint16_t CurrentLimiter::get_idle_ma() const {
+    return idle_ma.load(std::memory_order_relaxed);
+}
+
+// only called from the render task
+uint32_t CurrentLimiter::update(uint32_t new_sample_ma) {
+    uint32_t trim = get_trim_q16();
+    uint32_t idle = get_idle_ma();
+    uint32_t led_ma = new_sample_ma > idle ? new_sample_ma - idle : 0;
+    uint32_t demand_ma = static_cast<uint32_t>(std::min<uint64_t>(
+            static_cast<uint64_t>(led_ma) * TRIM_ONE / std::max(trim, TRIM_MIN), INT32_MAX >> 4));
+    int32_t demand_q4 = static_cast<int32_t>(this->demand_q4.load(std::memory_order_relaxed));
+    int32_t sample_q4 = static_cast<int32_t>(demand_ma << 4);
+    demand_q4 = has_sample ? demand_q4 + (sample_q4 - demand_q4) / (1 << FILTER_SHIFT) : sample_q4;
+    has_sample = true;
+
+    uint32_t filtered_ma = static_cast<uint32_t>(demand_q4) >> 4;
+    uint32_t budget = get_budget_ma();
+    uint32_t target = TRIM_ONE;
+    if (budget != 0 && filtered_ma + idle > budget) {
+        // a budget at or below the idle draw leaves nothing for the LEDs, and a dark strip gives no
+        // draw to divide by: both hold the minimum trim
+        uint32_t led_budget = budget > idle ? budget - idle : 0;
+        target = led_budget == 0 || filtered_ma == 0
+                 ? TRIM_MIN
+                 : std::max<uint32_t>(static_cast<uint64_t>(led_budget) * TRIM_ONE / filtered_ma, TRIM_MIN);
+    }
+    if (target < trim) {
+        trim = target;
+    } else {
+        trim += (target - trim + (1u << RELEASE_SHIFT) - 1) >> RELEASE_SHIFT;
+    }
+
+    this->demand_q4.store(static_cast<uint32_t>(demand_q4), std::memory_order_relaxed);
+    sample_ma.store(new_sample_ma, std::memory_order_relaxed);
+    trim_q16.store(trim, std::memory_order_relaxed);
+    return trim;
+}
+
+uint32_t CurrentLimiter::get_trim_q16() const {
+    return trim_q16.load(std::memory_order_relaxed);
+}
+
+uint32_t CurrentLimiter::get_demand_ma() const {
+    return (demand_q4.load(std::memory_order_relaxed) >> 4) + get_idle_ma();
+}
+
+uint32_t CurrentLimiter::get_sample_ma() const {
+    return sample_ma.load(std::memory_order_relaxed);
+}
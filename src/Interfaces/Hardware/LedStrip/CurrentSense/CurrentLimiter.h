@@ -0,0 +1,60 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: CurrentLimiter.h
+#ifndef CURRENTLIMITER_H
+#define CURRENTLIMITER_H
+
+#include <atomic>
+#include <cstdint>
+
+// Closed loop on the measured strip current. The idle draw (controller, LED drivers with the LEDs off)
+// does not follow the trim, so it is taken off every reading and only the LED part is divided by the
+// trim it was taken at; the filter tracks the LED draw at full output and a cut does not look like the
+// load went away. The trim is (budget - idle) / filtered LED draw: cuts apply at once, recovery moves
+// 1 / 2^RELEASE_SHIFT of the way per reading. LedStrip multiplies the trim into the output scale after the estimated power limit.
+// Fed by any CurrentSource
+class CurrentLimiter {
+public:
+    static constexpr uint32_t   TRIM_ONE            = 65536;
+    // below this the readings say too little about the load to divide by the trim
+    static constexpr uint32_t   TRIM_MIN            = TRIM_ONE / 256;
+    // weight of a new reading in the filter, 1 / 2^FILTER_SHIFT
+    static constexpr uint8_t    FILTER_SHIFT        = 3;
+    static constexpr uint8_t    RELEASE_SHIFT       = 4;
+
+    explicit CurrentLimiter                         (uint16_t budget_ma = 0, uint16_t idle_ma = 0);
+
+    // 0 disables the limit
+    void                        set_budget_ma       (uint16_t budget_ma);
+    uint16_t                    get_budget_ma       () const;
+    // draw with every LED off, it is part of the budget but no trim reduces it
+    void                        set_idle_ma         (uint16_t idle_ma);
+    uint16_t                    get_idle_ma         () const;
+
+    // feeds one reading, returns the new trim
+    uint32_t                    update              (uint32_t sample_ma);
+    uint32_t                    get_trim_q16        () const;
+    // filtered draw at full output, idle included, and the last raw reading
+    uint32_t                    get_demand_ma       () const;
+    uint32_t                    get_sample_ma       () const;
+
+private:
+    // written by the CLI, read by the render task
+    std::atomic<uint16_t>       budget_ma;
+    std::atomic<uint16_t>       idle_ma;
+    std::atomic<uint32_t>       trim_q16            {TRIM_ONE};
+    std::atomic<uint32_t>       demand_q4           {0};
+    std::atomic<uint32_t>       sample_ma           {0};
+    bool                        has_sample          = false;
+};
+
+#endif  // CURRENTLIMITER_H
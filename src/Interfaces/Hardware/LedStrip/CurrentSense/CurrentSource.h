@@ -0,0 +1,29 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: CurrentSource.h
+#ifndef CURRENTSOURCE_H
+#define CURRENTSOURCE_H
+
+#include <cstdint>
+
+// Where the strip current readings come from: the ADC on the dock (AdcCurrentSource) or a model
+// (SimulatedCurrentSource), so CurrentLimiter runs the same way on the device and on a desktop build
+class CurrentSource {
+public:
+    virtual ~CurrentSource                  () = default;
+
+    virtual bool            begin           () = 0;
+    // newest strip current in mA, false when no reading arrived since the last call
+    virtual bool            read_ma         (uint32_t& current_ma) = 0;
+};
+
+#endif  // CURRENTSOURCE_H
@@ -0,0 +1,40 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: SimulatedCurrentSource.h
+#ifndef SIMULATEDCURRENTSOURCE_H
+#define SIMULATEDCURRENTSOURCE_H
+
+#include "CurrentSource.h"
+
+// Stand-in for the sense pin off target: draws idle_ma plus load_ma scaled by the output scale it is
+// told about, which is how the real strip responds to the limiter trim
+class SimulatedCurrentSource : public CurrentSource {
+public:
+    explicit SimulatedCurrentSource         (uint32_t idle_ma = 0) : idle_ma(idle_ma) {}
+
+    bool            begin                   () override { return true; }
+    bool            read_ma                 (uint32_t& current_ma) override {
+        current_ma = idle_ma + static_cast<uint32_t>((static_cast<uint64_t>(load_ma) * output_scale_q16) >> 16);
+        return true;
+    }
+
+    // draw of the LEDs at full output, without the idle current
+    void            set_load_ma             (uint32_t new_load_ma)      { load_ma = new_load_ma; }
+    void            set_output_scale_q16    (uint32_t scale_q16)        { output_scale_q16 = scale_q16; }
+
+private:
+    uint32_t        idle_ma;
+    uint32_t        load_ma                 = 0;
+    uint32_t        output_scale_q16        = 65536;
+};
+
+#endif  // SIMULATEDCURRENTSOURCE_H
@@ -0,0 +1,54 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: Dither.h
+#ifndef DITHER_H
+#define DITHER_H
+
+#include <cstdint>
+#include "../../../../Config.h"
+
+#ifndef LED_STRIP_DITHER
+  #define LED_STRIP_DITHER              0
+#endif
+
+// Temporal dithering: the output pass keeps every channel in 8.8 fixed point and rounds it up or
+// down per frame, so a level between two 8 bit steps shows as the right mix of both over time
+constexpr uint8_t bit_reverse8(uint8_t value) {
+    value = static_cast<uint8_t>((value & 0xF0) >> 4 | (value & 0x0F) << 4);
+    value = static_cast<uint8_t>((value & 0xCC) >> 2 | (value & 0x33) << 2);
+    value = static_cast<uint8_t>((value & 0xAA) >> 1 | (value & 0x55) << 1);
+    return value;
+}
+
+// the bit reversed frame index rounds a fraction f/256 up in exactly f of every 256 frames and
+// spreads those frames evenly; the per pixel offset keeps neighbouring pixels from flipping together
+inline uint8_t dither_threshold(uint32_t frame_index, uint16_t pixel) {
+    return static_cast<uint8_t>(bit_reverse8(static_cast<uint8_t>(frame_index)) + pixel * 97);
+}
+
+// the threshold the output pass rounds with: dithered, or plain round to nearest without LED_STRIP_DITHER
+inline uint8_t output_threshold(uint32_t frame_index, uint16_t pixel) {
+#if LED_STRIP_DITHER
+    return dither_threshold(frame_index, pixel);
+#else
+    (void)frame_index;
+    (void)pixel;
+    return 128;
+#endif
+}
+
+inline uint8_t dither_quantize(uint16_t level_q8, uint8_t threshold) {
+    uint32_t level = (static_cast<uint32_t>(level_q8) + threshold) >> 8;
+    return level > 255 ? 255 : static_cast<uint8_t>(level);
+}
+
+#endif  // DITHER_H
@@ -0,0 +1,106 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: FrameStats.cpp
+#include "FrameStats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+uint8_t FrameStats::bucket(uint32_t us) {
+    if (us < 4) return static_cast<uint8_t>(us);
+    uint8_t msb = static_cast<uint8_t>(31 - __builtin_clz(us));
+    uint32_t index = (msb - 1u) * 4u + ((us >> (msb - 2)) & 3u);
+    return static_cast<uint8_t>(std::min<uint32_t>(index, BUCKETS - 1));
+}
+
+uint32_t FrameStats::bucket_upper_us(uint8_t index) {
+    if (index < 4) return index;
+    uint8_t shift = index / 4 - 1;
+    return ((4u + index % 4u + 1u) << shift) - 1u;
+}
+
+uint32_t FrameStats::Stage::percentile_us(uint16_t permille) const {
+    if (count == 0) return 0;
+    uint64_t rank = (static_cast<uint64_t>(count) * permille + 999) / 1000;
+    uint64_t seen = 0;
+    for (uint8_t i = 0; i < BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen >= rank) return std::min(bucket_upper_us(i), max_us);
+    }
+    return max_us;
+}
+
+// only the writer of a stage clears its bit, so a reset never races that stage's record()
+bool FrameStats::take_reset(uint8_t bit) {
+    uint8_t mask = static_cast<uint8_t>(1u << bit);
+    if (!(reset_pending.load(std::memory_order_relaxed) & mask)) return false;
+    reset_pending.fetch_and(static_cast<uint8_t>(~mask), std::memory_order_relaxed);
+    return true;
+}
+
+void FrameStats::record(FrameStage stage, uint32_t elapsed_us) {
+    uint8_t index = static_cast<uint8_t>(stage);
+    std::atomic<uint32_t>& seq = sequence[index];
+    uint32_t begin = seq.load(std::memory_order_relaxed);
+    seq.store(begin + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Stage& s = stages[index];
+    if (take_reset(index)) s = Stage{};
+    s.count++;
+    s.min_us  = std::min(s.min_us, elapsed_us);
+    s.max_us  = std::max(s.max_us, elapsed_us);
+    s.sum_us += elapsed_us;
+    s.buckets[bucket(elapsed_us)]++;
+
+    seq.store(begin + 2, std::memory_order_release);
+}
+
+void FrameStats::record_interval(uint32_t actual_us, uint32_t period_us) {
+    if (take_reset(DROPPED_BIT)) dropped.store(0, std::memory_order_relaxed);
+    if (period_us == 0 || actual_us <= period_us + period_us / 2) return;
+    dropped.fetch_add((actual_us + period_us / 2) / period_us - 1, std::memory_order_relaxed);
+}
+
+void FrameStats::reset() {
+    reset_pending.store(static_cast<uint8_t>((1u << (STAGES + 1)) - 1), std::memory_order_relaxed);
+}
+
+FrameStats::Stage FrameStats::snapshot(FrameStage stage) const {
+    uint8_t index = static_cast<uint8_t>(stage);
+    const std::atomic<uint32_t>& seq = sequence[index];
+    Stage copy;
+    for (uint32_t attempt = 1; ; attempt++) {
+        uint32_t begin = seq.load(std::memory_order_acquire);
+        copy = stages[index];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (!(begin & 1) && seq.load(std::memory_order_relaxed) == begin) return copy;
+        if (attempt % SNAPSHOT_SPINS == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+uint32_t FrameStats::get_dropped() const {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+const char* FrameStats::stage_name(FrameStage stage) {
+    switch (stage) {
+        case FrameStage::UPDATE:     return "update";
+        case FrameStage::RENDER:     return "render";
+        case FrameStage::CORRECTION: return "correct";
+        case FrameStage::WAIT:       return "wait";
+        case FrameStage::SHOW:       return "show";
+        case FrameStage::FRAME:      return "frame";
+        default:                     return "?";
+    }
+}
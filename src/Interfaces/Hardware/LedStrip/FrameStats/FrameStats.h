@@ -0,0 +1,84 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: FrameStats.h
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// stages of one frame, FRAME is the whole render_frame() call
+enum class FrameStage : uint8_t {
+    UPDATE,     // mode and segment loop(), transitions
+    RENDER,     // per pixel render() of spatial modes and crossfades
+    CORRECTION, // brightness, gamma, power limit and quantize into the back buffer
+    WAIT,       // publish waiting for the previous frame to leave the wire
+    SHOW,       // FastLED.show(), in the output task when there is one
+    FRAME,
+    COUNT
+};
+
+// Per-stage frame timing in fixed-size log histograms: exact below 4 us, then 4 buckets per power of two
+// (at most 25 % wide), anything past ~115 ms lands in the last one. min, max and the average are exact,
+// percentiles are the upper edge of their bucket.
+// Each stage has one writer (the render task, or the output task for SHOW) and is guarded by its own
+// sequence counter: snapshot() copies the stage and retries when a record() ran meanwhile, so count,
+// sum, max and the buckets of a copy always belong to the same frames.
+// reset() is only requested by readers and applied by the writer of each stage on its next record().
+// The strip times the stages and feeds it
+class FrameStats {
+public:
+    static constexpr uint8_t    BUCKETS             = 64;
+    static constexpr uint8_t    STAGES              = static_cast<uint8_t>(FrameStage::COUNT);
+
+    struct Stage {
+        uint32_t                count               = 0;
+        uint32_t                min_us              = UINT32_MAX;
+        uint32_t                max_us              = 0;
+        uint64_t                sum_us              = 0;
+        std::array<uint32_t, BUCKETS> buckets       = {};
+
+        uint32_t                avg_us              () const { return count ? sum_us / count : 0; }
+        uint32_t                percentile_us       (uint16_t permille) const;
+    };
+
+    void                        record              (FrameStage stage, uint32_t elapsed_us);
+    // frames that started more than half a period late, counted in whole missed periods
+    void                        record_interval     (uint32_t actual_us, uint32_t period_us);
+    void                        reset               ();
+
+    // consistent copy of a stage, taken while the writer may be recording
+    Stage                       snapshot            (FrameStage stage) const;
+    uint32_t                    get_dropped         () const;
+    static const char*          stage_name          (FrameStage stage);
+
+    static uint8_t              bucket              (uint32_t us);
+    static uint32_t             bucket_upper_us     (uint8_t index);
+
+private:
+    // bit per stage, plus DROPPED_BIT for the dropped counter
+    static constexpr uint8_t    DROPPED_BIT         = STAGES;
+    // torn copies a reader retries at once before it sleeps a tick, so a writer it preempted mid
+    // record() gets to finish
+    static constexpr uint8_t    SNAPSHOT_SPINS      = 8;
+
+    bool                        take_reset          (uint8_t bit);
+
+    std::array<Stage, STAGES>   stages;
+    // odd while the stage is being written
+    std::array<std::atomic<uint32_t>, STAGES> sequence {};
+    std::atomic<uint32_t>       dropped             {0};
+    std::atomic<uint8_t>        reset_pending       {0};
+};
+
+#endif  // FRAMESTATS_H
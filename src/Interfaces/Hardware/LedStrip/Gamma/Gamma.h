@@ -0,0 +1,103 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: Gamma.h
+#ifndef GAMMA_H
+#define GAMMA_H
+
+#include <FastLED.h>
+#include <array>
+#include <cstdint>
+#include "../../../../Config.h"
+
+#ifndef LED_STRIP_GAMMA_R
+  #define LED_STRIP_GAMMA_R             100
+  #define LED_STRIP_GAMMA_G             100
+  #define LED_STRIP_GAMMA_B             100
+#endif
+#ifndef LED_STRIP_WHITE_BALANCE_R
+  #define LED_STRIP_WHITE_BALANCE_R     255
+  #define LED_STRIP_WHITE_BALANCE_G     255
+  #define LED_STRIP_WHITE_BALANCE_B     255
+#endif
+
+// Output correction: gamma and white balance per channel, generated by the compiler into three
+// 256 byte tables in flash. The output pass maps every channel through them, one read per channel
+namespace gamma_math {
+
+// x = m * 2^e with m in [0.5, 1), then ln(m) = 2 atanh((m - 1) / (m + 1)), |z| <= 1/3 converges fast
+constexpr double ln(double x) {
+    int exponent = 0;
+    while (x < 0.5) { x *= 2; exponent--; }
+    while (x >= 1.0) { x /= 2; exponent++; }
+    double z = (x - 1) / (x + 1);
+    double z2 = z * z;
+    double term = z;
+    double sum = 0;
+    for (int n = 1; n < 60; n += 2) {
+        sum += term / n;
+        term *= z2;
+    }
+    return 2 * sum + exponent * 0.69314718055994530942;
+}
+
+// y <= 0 here; y = k ln2 + r with |r| <= ln2 / 2, Taylor series for e^r
+constexpr double exp(double y) {
+    int k = static_cast<int>(y / 0.69314718055994530942 + (y < 0 ? -0.5 : 0.5));
+    double r = y - k * 0.69314718055994530942;
+    double term = 1;
+    double sum = 1;
+    for (int n = 1; n < 30; n++) {
+        term *= r / n;
+        sum += term;
+    }
+    while (k > 0) { sum *= 2; k--; }
+    while (k < 0) { sum /= 2; k++; }
+    return sum;
+}
+
+}  // namespace gamma_math
+
+// table[i] = round(scale * (i / 255) ^ (gamma_x100 / 100))
+constexpr std::array<uint8_t, 256> make_gamma_table(uint16_t gamma_x100, uint8_t scale) {
+    std::array<uint8_t, 256> table = {};
+    for (int i = 1; i < 256; i++) {
+        double level = gamma_math::exp(gamma_math::ln(i / 255.0) * gamma_x100 / 100.0);
+        table[i] = static_cast<uint8_t>(level * scale + 0.5);
+    }
+    return table;
+}
+
+inline constexpr std::array<uint8_t, 256> GAMMA_R = make_gamma_table(LED_STRIP_GAMMA_R, LED_STRIP_WHITE_BALANCE_R);
+inline constexpr std::array<uint8_t, 256> GAMMA_G = make_gamma_table(LED_STRIP_GAMMA_G, LED_STRIP_WHITE_BALANCE_G);
+inline constexpr std::array<uint8_t, 256> GAMMA_B = make_gamma_table(LED_STRIP_GAMMA_B, LED_STRIP_WHITE_BALANCE_B);
+
+static_assert(GAMMA_R[255] == LED_STRIP_WHITE_BALANCE_R && GAMMA_G[255] == LED_STRIP_WHITE_BALANCE_G
+              && GAMMA_B[255] == LED_STRIP_WHITE_BALANCE_B, "gamma tables must end at the white balance");
+
+// an 8.8 fixed point level through a table, linear between neighbouring entries; the result is
+// 8.8 as well so dithering can use the fraction
+inline uint16_t gamma_correct_q8(const std::array<uint8_t, 256>& table, uint16_t level_q8) {
+    uint8_t index = level_q8 >> 8;
+    uint8_t fraction = level_q8 & 0xFF;
+    if (index == 255) return static_cast<uint16_t>(table[255] << 8);
+    return static_cast<uint16_t>((table[index] << 8) + (table[index + 1] - table[index]) * fraction);
+}
+
+inline CRGB gamma_correct(uint8_t r, uint8_t g, uint8_t b) {
+    return CRGB(GAMMA_R[r], GAMMA_G[g], GAMMA_B[b]);
+}
+
+inline CRGB gamma_correct(const std::array<uint8_t, 3>& rgb) {
+    return gamma_correct(rgb[0], rgb[1], rgb[2]);
+}
+
+#endif  // GAMMA_H
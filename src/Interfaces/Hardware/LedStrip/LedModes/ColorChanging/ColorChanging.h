@@ -15,24 +15,25 @@
 #define COLORCHANGING_H
 
 #include "../LedMode.h"
-#include "../../LedStrip.h"
-#include "../../AsyncTimer/AsyncTimerArray.h"
+#include "../../AsyncTimer/Transition.h"
 
 class ColorChanging : public LedMode {
 public:
     ColorChanging                           (LedStrip* led_strip,
                                              uint8_t current_r, uint8_t current_g, uint8_t current_b,
                                              uint8_t t0, uint8_t t1, uint8_t t2,
-                                             char mode, uint32_t duration_ms);
+                                             char mode, uint32_t duration_ms,
+                                             Easing easing = Easing::LINEAR);
     ~ColorChanging                          () override = default;
 
     void                    loop            () override;
     bool                    is_done         () override;
-    uint8_t                 get_mode_id     () override;
-    String                  get_mode_name   () override;
-    uint8_t                 get_target_mode_id     () override;
-    String                  get_target_mode_name   () override;
+    const LedModeInfo&      get_info        () const override;
+    const LedModeInfo&      get_target_info () const override;
+    // internal mode: created by set_rgb/set_hsv with a target, not selectable through set_mode
+    static constexpr LedModeInfo INFO       {1, "Color Changing", nullptr, 10};
 
+    CRGB16                  get_rgb16       () override;
     std::array<uint8_t, 3>  get_target_rgb  () override;
     uint8_t                 get_target_r    () override;
     uint8_t                 get_target_g    () override;
@@ -44,7 +45,9 @@ public:
     uint8_t                 get_target_v    () override;
 
 private:
-    std::unique_ptr<AsyncTimerArray>            timer;
+    Transition<uint8_t, 3>                      timer;
+    // transition color with its fraction, get_rgb() is this rounded to 8 bits
+    CRGB16                                      rgb16;
 };
 
 #endif  // COLORCHANGING_H
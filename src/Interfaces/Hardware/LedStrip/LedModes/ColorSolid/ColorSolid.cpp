@@ -34,30 +34,16 @@ bool ColorSolid::is_done() {
     return id_done_flag;
 }
 
-uint8_t ColorSolid::get_mode_id() {
-    DBG_PRINTLN(ColorSolid, "-> ColorSolid::get_mode_id()");
-    uint8_t result = 0;
-    DBG_PRINTF(ColorSolid, "<- ColorSolid::get_mode_id() returns: %u\n", result);
-    return result;
-}
-
-String ColorSolid::get_mode_name() {
-    DBG_PRINTLN(ColorSolid, "-> ColorSolid::get_mode_name()");
-    String result = "Color Solid";
-    DBG_PRINTF(ColorSolid, "<- ColorSolid::get_mode_name() returns: %s\n", result.c_str());
-    return result;
+bool ColorSolid::is_static() const {
+    return true;
 }
 
-uint8_t ColorSolid::get_target_mode_id() {
-    DBG_PRINTLN(ColorChanging, "-> ColorChanging::get_target_mode_id()");
-    DBG_PRINTLN(ColorChanging, "<- ColorChanging::get_target_mode_id()");
-    return get_mode_id();
+const LedModeInfo& ColorSolid::get_info() const {
+    return INFO;
 }
 
-String ColorSolid::get_target_mode_name() {
-    DBG_PRINTLN(ColorChanging, "-> ColorChanging::get_target_mode_name()");
-    DBG_PRINTLN(ColorChanging, "<- ColorChanging::get_target_mode_name()");
-    return get_mode_name();
+LedMode* ColorSolid::create(void* storage, LedStrip* led_strip, std::array<uint8_t, 3> rgb) {
+    return new (storage) ColorSolid(led_strip, rgb[0], rgb[1], rgb[2]);
 }
 
 std::array<uint8_t, 3> ColorSolid::get_target_rgb() {
@@ -15,7 +15,6 @@
 #define COLORSOLID_H
 
 #include "../LedMode.h"
-#include "../../LedStrip.h"
 
 class ColorSolid : public LedMode {
 public:
@@ -24,10 +23,10 @@ public:
 
     void                    loop            () override;
     bool                    is_done         () override;
-    uint8_t                 get_mode_id     () override;
-    String                  get_mode_name   () override;
-    uint8_t                 get_target_mode_id     () override;
-    String                  get_target_mode_name   () override;
+    bool                    is_static       () const override;
+    const LedModeInfo&      get_info        () const override;
+    static LedMode*         create          (void* storage, LedStrip* led_strip, std::array<uint8_t, 3> rgb);
+    static constexpr LedModeInfo INFO       {0, "Color Solid", &ColorSolid::create, 10};
 
     std::array<uint8_t, 3>  get_target_rgb  () override;
     uint8_t                 get_target_r    () override;
@@ -0,0 +1,102 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: HsvConvert.h
+#ifndef HSVCONVERT_H
+#define HSVCONVERT_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+// Integer HSV <-> RGB, no float on the hot path (the C3 has no FPU).
+// hsv_to_rgb keeps the original quantization: hue in whole degrees and saturation/value in
+// whole percent (Arduino map() steps), then rounds the exact sector values to 0-255.
+// rgb_to_hsv is the exact hexcone model the shader style float formula approximated,
+// truncated to 0-255 like before.
+// Against the float code a channel differs by at most 1 LSB, where the float error sat on a rounding
+// boundary (8435 HSV and 749149 RGB inputs of 2^24); scripts/host/hsv_convert_test.cpp checks every input.
+// Plain C++, shared by LedMode and the host test
+namespace hsv_convert {
+    struct HsvSteps {
+        std::array<uint16_t, 256>   degrees         {};
+        std::array<uint8_t, 256>    percent         {};
+        std::array<uint8_t, 101>    percent_to_byte {};
+    };
+
+    constexpr HsvSteps make_hsv_steps() {
+        HsvSteps steps;
+        for (uint16_t i = 0; i < 256; i++) {
+            steps.degrees[i] = i * 360 / 255;
+            steps.percent[i] = i * 100 / 255;
+        }
+        for (uint16_t i = 0; i <= 100; i++) {
+            steps.percent_to_byte[i] = (i * 255 + 50) / 100;
+        }
+        return steps;
+    }
+
+    inline constexpr HsvSteps HSV_STEPS = make_hsv_steps();
+
+    inline uint8_t round_div(uint32_t numerator, uint32_t denominator) {
+        return static_cast<uint8_t>((numerator + denominator / 2) / denominator);
+    }
+
+    inline void hsv_to_rgb_pixel(uint8_t h, uint8_t s, uint8_t v, uint8_t& r, uint8_t& g, uint8_t& b) {
+        uint32_t sat = HSV_STEPS.percent[s];
+        uint32_t val = HSV_STEPS.percent[v];
+        uint8_t  top = HSV_STEPS.percent_to_byte[val];
+        if (sat == 0) {
+            r = g = b = top;
+            return;
+        }
+        uint16_t degrees = HSV_STEPS.degrees[h];
+        uint8_t  sector  = degrees / 60;
+        uint32_t part    = degrees % 60;
+        if (!(sector & 1)) part = 60 - part;
+        // bottom = v * (1 - s), slope = v * (1 - s * part / 60), both scaled to 0-255
+        uint8_t bottom = round_div(val * (100 - sat) * 255, 100 * 100);
+        uint8_t slope  = round_div(val * (6000 - sat * part) * 255, 100 * 100 * 60);
+        switch (sector) {
+            case 0:
+            case 6: r = top;    g = slope;  b = bottom; break;
+            case 1: r = slope;  g = top;    b = bottom; break;
+            case 2: r = bottom; g = top;    b = slope;  break;
+            case 3: r = bottom; g = slope;  b = top;    break;
+            case 4: r = slope;  g = bottom; b = top;    break;
+            default: r = top;   g = bottom; b = slope;  break;
+        }
+    }
+
+    inline void rgb_to_hsv_pixel(uint8_t r, uint8_t g, uint8_t b, uint8_t& h, uint8_t& s, uint8_t& v) {
+        uint8_t max_channel = std::max({r, g, b});
+        uint8_t min_channel = std::min({r, g, b});
+        uint32_t delta = max_channel - min_channel;
+        v = max_channel;
+        if (delta == 0) {
+            h = s = 0;
+            return;
+        }
+        // hue in units of 1 / (6 * delta) of a full turn
+        int32_t hue_units;
+        if (max_channel == r) {
+            hue_units = g >= b ? g - b : 6 * delta + g - b;
+        } else if (max_channel == g) {
+            hue_units = 2 * delta + b - r;
+        } else {
+            hue_units = 4 * delta + r - g;
+        }
+        h = static_cast<uint8_t>(255 * static_cast<uint32_t>(hue_units) / (6 * delta));
+        s = static_cast<uint8_t>(255 * delta / max_channel);
+    }
+}  // namespace hsv_convert
+
+#endif  // HSVCONVERT_H
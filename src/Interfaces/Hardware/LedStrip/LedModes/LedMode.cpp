@@ -12,6 +12,7 @@
 
 // File: LedMode.cpp
 #include "LedMode.h"
+#include "HsvConvert.h"
 
 // Assuming Debug.h is available and provides DBG_PRINTF/DBG_PRINTLN macros.
 
@@ -28,6 +29,38 @@ LedMode::~LedMode() {
     DBG_PRINTLN(LedMode, "<- LedMode::~LedMode()");
 }
 
+void LedMode::render(std::span<CRGB> out, FrameContext& ctx) {
+    fill_solid(out.data(), out.size(), CRGB(rgb[0], rgb[1], rgb[2]));
+}
+
+bool LedMode::is_uniform() const {
+    return true;
+}
+
+bool LedMode::is_static() const {
+    return false;
+}
+
+const LedModeInfo& LedMode::get_target_info() const {
+    return get_info();
+}
+
+uint8_t LedMode::get_mode_id() const {
+    return get_info().id;
+}
+
+uint8_t LedMode::get_target_mode_id() const {
+    return get_target_info().id;
+}
+
+const char* LedMode::get_mode_name() const {
+    return get_info().name;
+}
+
+const char* LedMode::get_target_mode_name() const {
+    return get_target_info().name;
+}
+
 void LedMode::set_rgb(std::array<uint8_t, 3> new_rgb) {
     DBG_PRINTF(LedMode, "-> LedMode::set_rgb(rgb: {%u, %u, %u})\n", new_rgb[0], new_rgb[1], new_rgb[2]);
     this->rgb = new_rgb;
@@ -104,6 +137,10 @@ uint8_t LedMode::get_b() {
     return rgb[2];
 }
 
+CRGB16 LedMode::get_rgb16() {
+    return to_rgb16(rgb);
+}
+
 std::array<uint8_t, 3> LedMode::get_hsv() {
     DBG_PRINTLN(LedMode, "-> LedMode::get_hsv()");
     std::array<uint8_t, 3> hsv = LedMode::rgb_to_hsv(this->rgb);
@@ -132,120 +169,30 @@ uint8_t LedMode::get_v() {
     return v;
 }
 
-// Convert RGB → HSV
 std::array<uint8_t, 3> LedMode::rgb_to_hsv(std::array<uint8_t, 3> input_rgb) {
     DBG_PRINTF(LedMode, "-> LedMode::rgb_to_hsv(input_rgb: {%u, %u, %u})\n", input_rgb[0], input_rgb[1], input_rgb[2]);
-
-    float r = input_rgb[0] / 255.0f;
-    float g = input_rgb[1] / 255.0f;
-    float b = input_rgb[2] / 255.0f;
-
-    float s = step(b, g);
-    float px = mix(b, g, s);
-    float py = mix(g, b, s);
-    float pz = mix(-1.0f, 0.0f, s);
-    float pw = mix(0.6666666f, -0.3333333f, s);
-    s = step(px, r);
-    float qx = mix(px, r, s);
-    float qz = mix(pw, pz, s);
-    float qw = mix(r, px, s);
-    float d = qx - min(qw, py);
-    float hue_float = abs(qz + (qw - py) / (6.0f * d + 1e-10f));
-    float sat_float = d / (qx + 1e-10f);
-    // hsv[2] = qx; not used for this lib
-
-    std::array<uint8_t, 3> output_hsv = {(uint8_t)(hue_float * 255), (uint8_t)(sat_float * 255), (uint8_t)(qx * 255)};
-
+    std::array<uint8_t, 3> output_hsv;
+    hsv_convert::rgb_to_hsv_pixel(input_rgb[0], input_rgb[1], input_rgb[2], output_hsv[0], output_hsv[1], output_hsv[2]);
     DBG_PRINTF(LedMode, "<- LedMode::rgb_to_hsv() returns: {%u, %u, %u}\n", output_hsv[0], output_hsv[1], output_hsv[2]);
-
     return output_hsv;
 }
 
 std::array<uint8_t, 3> LedMode::hsv_to_rgb(std::array<uint8_t, 3> input_hsv) {
     DBG_PRINTF(LedMode, "-> LedMode::hsv_to_rgb(input_hsv: {%u, %u, %u})\n", input_hsv[0], input_hsv[1], input_hsv[2]);
-
-    float h_float = map(input_hsv[0], 0, 255, 0, 360);
-    float s_float = map(input_hsv[1], 0, 255, 0, 100);
-    float v_float = map(input_hsv[2], 0, 255, 0, 100);
-
-    int i;
-    float m, n, f;
-    std::array<uint8_t, 3> rgb_temp = {0, 0, 0};
-    s_float /= 100;
-    v_float /= 100;
-
-    if (s_float == 0) {
-        rgb_temp[0] = rgb_temp[1] = rgb_temp[2] = round(v_float * 255);
-        DBG_PRINTF(LedMode, "<- LedMode::hsv_to_rgb() returns (grayscale): {%u, %u, %u}\n", rgb_temp[0], rgb_temp[1], rgb_temp[2]);
-        return {rgb_temp[0], rgb_temp[1], rgb_temp[2]};
-    }
-
-    h_float /= 60;
-    i = floor(h_float);
-    f = h_float - i;
-
-    if (!(i & 1)) {
-        f = 1 - f;
-    }
-
-    m = v_float * (1 - s_float);
-    n = v_float * (1 - s_float * f);
-
-    switch (i) {
-        case 0:
-        case 6:
-            rgb_temp[0] = round(v_float * 255);
-            rgb_temp[1] = round(n * 255);
-            rgb_temp[2] = round(m * 255);
-            break;
-        case 1:
-            rgb_temp[0] = round(n * 255);
-            rgb_temp[1] = round(v_float * 255);
-            rgb_temp[2] = round(m * 255);
-            break;
-        case 2:
-            rgb_temp[0] = round(m * 255);
-            rgb_temp[1] = round(v_float * 255);
-            rgb_temp[2] = round(n * 255);
-            break;
-        case 3:
-            rgb_temp[0] = round(m * 255);
-            rgb_temp[1] = round(n * 255);
-            rgb_temp[2] = round(v_float * 255);
-            break;
-        case 4:
-            rgb_temp[0] = round(n * 255);
-            rgb_temp[1] = round(m * 255);
-            rgb_temp[2] = round(v_float * 255);
-            break;
-        case 5:
-            rgb_temp[0] = round(v_float * 255);
-            rgb_temp[1] = round(m * 255);
-            rgb_temp[2] = round(n * 255);
-            break;
-    }
-
-    DBG_PRINTF(LedMode, "<- LedMode::hsv_to_rgb() returns: {%u, %u, %u}\n", rgb_temp[0], rgb_temp[1], rgb_temp[2]);
-    return {rgb_temp[0], rgb_temp[1], rgb_temp[2]};
+    std::array<uint8_t, 3> output_rgb;
+    hsv_convert::hsv_to_rgb_pixel(input_hsv[0], input_hsv[1], input_hsv[2], output_rgb[0], output_rgb[1], output_rgb[2]);
+    DBG_PRINTF(LedMode, "<- LedMode::hsv_to_rgb() returns: {%u, %u, %u}\n", output_rgb[0], output_rgb[1], output_rgb[2]);
+    return output_rgb;
 }
 
-float LedMode::fract(float x) {
-//    DBG_PRINTF(LedMode, "-> LedMode::fract(x: %f)\n", x);
-    float result = x - int(x);
-//    DBG_PRINTF(LedMode, "<- LedMode::fract() returns: %f\n", result);
-    return result;
+void LedMode::hsv_to_rgb(const CHSV* input_hsv, CRGB* output_rgb, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        hsv_convert::hsv_to_rgb_pixel(input_hsv[i].h, input_hsv[i].s, input_hsv[i].v, output_rgb[i].r, output_rgb[i].g, output_rgb[i].b);
+    }
 }
 
-float LedMode::mix(float a, float b, float t) {
-//    DBG_PRINTF(LedMode, "-> LedMode::mix(a: %f, b: %f, t: %f)\n", a, b, t);
-    float result = a + (b - a) * t;
-//    DBG_PRINTF(LedMode, "<- LedMode::mix() returns: %f\n", result);
-    return result;
+void LedMode::rgb_to_hsv(const CRGB* input_rgb, CHSV* output_hsv, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        hsv_convert::rgb_to_hsv_pixel(input_rgb[i].r, input_rgb[i].g, input_rgb[i].b, output_hsv[i].h, output_hsv[i].s, output_hsv[i].v);
+    }
 }
-
-float LedMode::step(float e, float x) {
-//    DBG_PRINTF(LedMode, "-> LedMode::step(e: %f, x: %f)\n", e, x);
-    float result = x < e ? 0.0 : 1.0;
-//    DBG_PRINTF(LedMode, "<- LedMode::step() returns: %f\n", result);
-    return result;
-}
\ No newline at end of file
@@ -16,12 +16,44 @@
 
 #include <FastLED.h>
 #include <array>
+#include <new>
+#include <span>
 #include <cmath>
 #include <algorithm>
 #include "../../../../Debug.h"
-#include "../AsyncTimer/AsyncTimerArray.h"
+#include "../AsyncTimer/Transition.h"
 
 class LedStrip;
+class LedMode;
+
+// One row of the mode registry (LedModeRegistry.h). Every mode defines its row as a constexpr INFO
+// member, so id, name and factory live in flash and are never built at runtime
+struct LedModeInfo {
+    uint8_t                     id;
+    const char*                 name;
+    // constructs the mode showing rgb in place in storage (a LedModeSlot),
+    // nullptr for internal modes that set_mode can not select
+    LedMode*                    (*create)           (void* storage, LedStrip* led_strip, std::array<uint8_t, 3> rgb);
+    // render() cost allowed per frame, in 1/1000 of the frame interval at the current strip length.
+    // the interval follows the wire time (LedStrip::auto_frame_delay), so the share holds at any length.
+    // the values are targets, "$led benchmark" measures against them
+    uint16_t                    frame_budget_permille;
+};
+
+// Timing of the frame being rendered, filled once per frame by LedStrip and shared by every mode
+struct FrameContext {
+    uint32_t                    now_us              = 0;    // micros() at the start of the frame
+    uint32_t                    delta_us            = 0;    // time since the previous frame
+    uint32_t                    frame_index         = 0;
+};
+
+// a color with 8 fraction bits per channel (channel * 256). transitions, crossfades and brightness are
+// carried at this precision from the mode to the output pass and quantized to 8 bits only there
+using CRGB16 = std::array<uint16_t, 3>;
+
+inline CRGB16 to_rgb16(const std::array<uint8_t, 3>& rgb) {
+    return {static_cast<uint16_t>(rgb[0] << 8), static_cast<uint16_t>(rgb[1] << 8), static_cast<uint16_t>(rgb[2] << 8)};
+}
 
 class LedMode {
 protected:
@@ -35,6 +67,14 @@ public:
 
     virtual void                    loop                () = 0;
     virtual bool                    is_done             () = 0;
+    // writes the mode output for one frame straight into the framebuffer (undimmed),
+    // the default is the current color on every pixel
+    virtual void                    render              (std::span<CRGB> out, FrameContext& ctx);
+    // true when every pixel equals get_rgb(), so the strip can fill one color and skip unchanged frames.
+    // spatial modes return false and are rendered through render() every frame
+    virtual bool                    is_uniform          () const;
+    // true when the output never changes on its own, so the render task may park until something is set
+    virtual bool                    is_static           () const;
 
     // Setters
     void                        set_rgb             (std::array<uint8_t, 3> rgb);
@@ -52,6 +92,8 @@ public:
     uint8_t                     get_r               ();
     uint8_t                     get_g               ();
     uint8_t                     get_b               ();
+    // current color before rounding to 8 bits, modes that interpolate colors override it
+    virtual CRGB16                  get_rgb16           ();
     virtual std::array<uint8_t, 3>  get_target_rgb      () = 0;
     virtual uint8_t                 get_target_r        () = 0;
     virtual uint8_t                 get_target_g        () = 0;
@@ -66,17 +108,20 @@ public:
     virtual uint8_t                 get_target_s        () = 0;
     virtual uint8_t                 get_target_v        () = 0;
 
-    virtual uint8_t                 get_mode_id         () = 0;
-    virtual uint8_t                 get_target_mode_id  () = 0;
-    virtual String                  get_mode_name       () = 0;
-    virtual String                  get_target_mode_name() = 0;
+    // registry row of the mode, a mode that settles into another one reports that one as target
+    virtual const LedModeInfo&      get_info            () const = 0;
+    virtual const LedModeInfo&      get_target_info     () const;
+    uint8_t                         get_mode_id         () const;
+    uint8_t                         get_target_mode_id  () const;
+    const char*                     get_mode_name       () const;
+    const char*                     get_target_mode_name() const;
 
     // Static color conversion utilities
     static std::array<uint8_t, 3>   rgb_to_hsv          (std::array<uint8_t, 3> input_rgb);
     static std::array<uint8_t, 3>   hsv_to_rgb          (std::array<uint8_t, 3> input_hsv);
-    static float                    fract               (float x);
-    static float                    mix                 (float a, float b, float t);
-    static float                    step                (float e, float x);
+    // batch versions for per-pixel effects, input and output may not overlap
+    static void                     hsv_to_rgb          (const CHSV* input_hsv, CRGB* output_rgb, uint16_t count);
+    static void                     rgb_to_hsv          (const CRGB* input_rgb, CHSV* output_hsv, uint16_t count);
 };
 
 #endif  // LEDMODE_H
\ No newline at end of file
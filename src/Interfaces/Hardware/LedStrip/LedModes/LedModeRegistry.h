@@ -0,0 +1,118 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: LedModeRegistry.h
+#ifndef LEDMODEREGISTRY_H
+#define LEDMODEREGISTRY_H
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include "LedMode.h"
+#include "LedModeSlot.h"
+#include "ColorSolid/ColorSolid.h"
+#include "ColorChanging/ColorChanging.h"
+#include "PerlinFade/PerlinFade.h"
+#include "PaletteFlow/PaletteFlow.h"
+
+// Every LedMode, in id order. The LED_MODES table and the in-place mode slot of the strip are both
+// generated from this list, adding a mode means adding its class here and nothing else
+using LedModeTypes = std::tuple<ColorSolid, ColorChanging, PerlinFade, PaletteFlow>;
+
+namespace led_mode_registry {
+
+template <typename... Modes>
+constexpr std::array<LedModeInfo, sizeof...(Modes)> make_table(std::tuple<Modes...>*) {
+    return {Modes::INFO...};
+}
+
+template <typename... Modes>
+LedModeSlot<Modes...> make_slot(std::tuple<Modes...>*);
+
+}  // namespace led_mode_registry
+
+// Compile time table of every LedMode. set_mode, the mode names and the web /modes list are all
+// generated from it
+inline constexpr auto LED_MODES = led_mode_registry::make_table(static_cast<LedModeTypes*>(nullptr));
+
+// slot big enough for any mode, used by the strip and by every segment, so a zone can run any mode
+using StripModeSlot     = decltype(led_mode_registry::make_slot(static_cast<LedModeTypes*>(nullptr)));
+using SegmentModeSlot   = StripModeSlot;
+
+constexpr const LedModeInfo* find_led_mode(uint8_t id) {
+    for (const LedModeInfo& info : LED_MODES) {
+        if (info.id == id) return &info;
+    }
+    return nullptr;
+}
+
+namespace led_mode_registry {
+
+constexpr bool ids_unique() {
+    for (size_t i = 0; i < LED_MODES.size(); i++) {
+        for (size_t j = i + 1; j < LED_MODES.size(); j++) {
+            if (LED_MODES[i].id == LED_MODES[j].id) return false;
+        }
+    }
+    return true;
+}
+static_assert(ids_unique(), "LED_MODES: two modes share an id");
+
+constexpr size_t text_length(const char* text) {
+    size_t length = 0;
+    while (text[length] != '\0') length++;
+    return length;
+}
+
+constexpr size_t digit_count(uint8_t value) {
+    return value >= 100 ? 3 : value >= 10 ? 2 : 1;
+}
+
+// {"<id>":"<name>",...} of the selectable modes, without the terminating zero
+constexpr size_t modes_json_length() {
+    size_t length = 2;
+    size_t listed = 0;
+    for (const LedModeInfo& info : LED_MODES) {
+        if (!info.create) continue;
+        length += digit_count(info.id) + text_length(info.name) + 5 + (listed++ ? 1 : 0);
+    }
+    return length;
+}
+
+constexpr std::array<char, modes_json_length() + 1> build_modes_json() {
+    std::array<char, modes_json_length() + 1> json = {};
+    size_t pos = 0;
+    json[pos++] = '{';
+    for (const LedModeInfo& info : LED_MODES) {
+        if (!info.create) continue;
+        if (pos > 1) json[pos++] = ',';
+        json[pos++] = '"';
+        if (info.id >= 100) json[pos++] = '0' + info.id / 100;
+        if (info.id >= 10)  json[pos++] = '0' + info.id / 10 % 10;
+        json[pos++] = '0' + info.id % 10;
+        json[pos++] = '"';
+        json[pos++] = ':';
+        json[pos++] = '"';
+        for (size_t i = 0; info.name[i] != '\0'; i++) json[pos++] = info.name[i];
+        json[pos++] = '"';
+    }
+    json[pos++] = '}';
+    json[pos] = '\0';
+    return json;
+}
+
+}  // namespace led_mode_registry
+
+// the web /modes payload, built by the compiler
+inline constexpr std::array<char, led_mode_registry::modes_json_length() + 1> LED_MODES_JSON =
+    led_mode_registry::build_modes_json();
+
+#endif  // LEDMODEREGISTRY_H
@@ -0,0 +1,97 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: LedModeSlot.h
+#ifndef LEDMODESLOT_H
+#define LEDMODESLOT_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "LedMode.h"
+#include "../../../../AllocationCounter.h"
+
+// switch statistics of a group of slots
+struct LedModeSlotStats {
+    std::atomic<uint32_t>                   switches            {0};
+    // operator new calls of the switching task while a mode was being built, stays 0 when mode
+    // changes are heap free
+    std::atomic<uint32_t>                   switch_allocations  {0};
+};
+
+// shared by the strip and segment slots, shown in LedStrip::status()
+inline LedModeSlotStats led_mode_slot_stats;
+
+// Fixed storage for one LedMode, sized and aligned for the largest of Modes. A mode change destroys
+// the current mode and constructs the next one in the same bytes, so it never touches the heap
+template <typename... Modes>
+class LedModeSlot {
+public:
+    static constexpr size_t     CAPACITY            = std::max({sizeof(Modes)...});
+
+                                LedModeSlot         () = default;
+    // a slot outside the strip (the benchmark) counts into its own stats
+    explicit                    LedModeSlot         (LedModeSlotStats& stats) : stats(&stats) {}
+                                ~LedModeSlot        () { reset(); }
+                                LedModeSlot         (const LedModeSlot&) = delete;
+    LedModeSlot&                operator=           (const LedModeSlot&) = delete;
+
+    // the current mode is destroyed before the new one is built,
+    // so arguments must be values, never references into the current mode
+    template <typename T, typename... Args>
+    T&                          emplace             (Args&&... args) {
+        static_assert((std::is_same_v<T, Modes> || ...), "LedModeSlot: mode is not one of the slot modes");
+        TaskAllocationScope allocations;
+        reset();
+        T* created = new (storage) T(std::forward<Args>(args)...);
+        mode = created;
+        count_switch(allocations.count());
+        return *created;
+    }
+
+    // builds the mode of a registry row, nullptr (slot left untouched) for modes without a factory.
+    // the row has to belong to one of Modes, LedModeRegistry.h builds both from one type list
+    LedMode*                    emplace             (const LedModeInfo& info, LedStrip* led_strip,
+                                                     std::array<uint8_t, 3> rgb) {
+        if (!info.create) return nullptr;
+        TaskAllocationScope allocations;
+        reset();
+        mode = info.create(storage, led_strip, rgb);
+        count_switch(allocations.count());
+        return mode;
+    }
+
+    void                        reset               () {
+        if (mode) {
+            mode->~LedMode();
+            mode = nullptr;
+        }
+    }
+
+    LedMode*                    get                 () const { return mode; }
+    LedMode*                    operator->          () const { return mode; }
+    explicit                    operator bool       () const { return mode != nullptr; }
+
+private:
+    void                        count_switch        (uint32_t allocations) {
+        stats->switches.fetch_add(1, std::memory_order_relaxed);
+        stats->switch_allocations.fetch_add(allocations, std::memory_order_relaxed);
+    }
+
+    alignas(Modes...) unsigned char storage         [CAPACITY];
+    LedMode*                    mode                = nullptr;
+    LedModeSlotStats*           stats               = &led_mode_slot_stats;
+};
+
+#endif  // LEDMODESLOT_H
@@ -0,0 +1,86 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: PaletteFlow.cpp
+#include "PaletteFlow.h"
+#include "../../LedStrip.h"
+
+PaletteFlow::PaletteFlow(LedStrip* led_strip, uint8_t r, uint8_t g, uint8_t b)
+    : LedMode(led_strip)
+{
+    DBG_PRINTF(PaletteFlow, "-> PaletteFlow::PaletteFlow(led_strip: %p, r: %u, g: %u, b: %u)\n", (void*)led_strip, r, g, b);
+    set_rgb({r, g, b});
+    DBG_PRINTLN(PaletteFlow, "<- PaletteFlow::PaletteFlow()");
+}
+
+void PaletteFlow::loop() {
+}
+
+bool PaletteFlow::is_done() {
+    return false;
+}
+
+// the palette index advances in 8.8 fixed point so the whole table spans the strip at any length
+void PaletteFlow::render(std::span<CRGB> out, FrameContext& ctx) {
+    if (out.empty()) return;
+    const CRGB* lut = led_strip->get_palette().data();
+    const uint16_t step = 0xFFFF / out.size();
+    uint16_t index = static_cast<uint16_t>((ctx.now_us >> TIME_SHIFT) << 8);
+    for (CRGB& pixel : out) {
+        pixel = lut[index >> 8];
+        index += step;
+    }
+}
+
+bool PaletteFlow::is_uniform() const {
+    return false;
+}
+
+const LedModeInfo& PaletteFlow::get_info() const {
+    return INFO;
+}
+
+LedMode* PaletteFlow::create(void* storage, LedStrip* led_strip, std::array<uint8_t, 3> rgb) {
+    return new (storage) PaletteFlow(led_strip, rgb[0], rgb[1], rgb[2]);
+}
+
+// the colors come from the palette, the set color is kept so switching back to a color mode restores it
+std::array<uint8_t, 3> PaletteFlow::get_target_rgb() {
+    return get_rgb();
+}
+
+uint8_t PaletteFlow::get_target_r() {
+    return get_r();
+}
+
+uint8_t PaletteFlow::get_target_g() {
+    return get_g();
+}
+
+uint8_t PaletteFlow::get_target_b() {
+    return get_b();
+}
+
+std::array<uint8_t, 3> PaletteFlow::get_target_hsv() {
+    return get_hsv();
+}
+
+uint8_t PaletteFlow::get_target_h() {
+    return get_h();
+}
+
+uint8_t PaletteFlow::get_target_s() {
+    return get_s();
+}
+
+uint8_t PaletteFlow::get_target_v() {
+    return get_v();
+}
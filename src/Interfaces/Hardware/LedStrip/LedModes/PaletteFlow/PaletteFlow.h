@@ -0,0 +1,47 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: PaletteFlow.h
+#ifndef PALETTE_FLOW_H
+#define PALETTE_FLOW_H
+
+#include "../LedMode.h"
+
+// The selected palette stretched once over the strip and scrolled along it. One table read per pixel
+class PaletteFlow : public LedMode {
+public:
+    PaletteFlow                             (LedStrip* led_strip, uint8_t r, uint8_t g, uint8_t b);
+    ~PaletteFlow                            () override = default;
+
+    void                    loop            () override;
+    bool                    is_done         () override;
+    void                    render          (std::span<CRGB> out, FrameContext& ctx) override;
+    bool                    is_uniform      () const override;
+
+    const LedModeInfo&      get_info        () const override;
+    static LedMode*         create          (void* storage, LedStrip* led_strip, std::array<uint8_t, 3> rgb);
+    static constexpr LedModeInfo INFO       {3, "Palette Flow", &PaletteFlow::create, 25};
+
+    std::array<uint8_t, 3>  get_target_rgb  () override;
+    uint8_t                 get_target_r    () override;
+    uint8_t                 get_target_g    () override;
+    uint8_t                 get_target_b    () override;
+
+    std::array<uint8_t, 3>  get_target_hsv  () override;
+    uint8_t                 get_target_h    () override;
+    uint8_t                 get_target_s    () override;
+    uint8_t                 get_target_v    () override;
+
+private:
+    static constexpr uint8_t    TIME_SHIFT      = 15;   // micros() >> 15, one palette step every ~33 ms
+};
+
+#endif // PALETTE_FLOW_H
@@ -9,63 +9,97 @@
  *********************************************************************************/
 
 
+// File: PerlinFade.cpp
+#include "PerlinFade.h"
 
-//#include "PerlinFade.h"
-//
-//// Constructor
-//PerlinFade::PerlinFade(LedController* controller)
-//    : LedMode(controller), counter(0) { // Initialize base class and members
-
-//    led_controller = controller;
-//
-//    // Initialize PerlinFade parameters using configuration values
-//    timer->reset(LedMode::get_hue() * 255, LedMode::get_hue() * 255, get_config_value("perlin_hue_transition_delay"));
-//    hue_gap = get_config_value("perlin_hue_gap");
-//    fire_step = get_config_value("perlin_fire_step");
-//    min_bright = get_config_value("perlin_min_bright");
-//    max_bright = get_config_value("perlin_max_bright");
-//    min_sat = get_config_value("perlin_min_sat");
-//    max_sat = get_config_value("perlin_max_sat");
-//    half_hue_gap = hue_gap / 2;
-//
-//    // Adjust hue gap
-//    adjusted_hue_gap = hue_gap;
-//    adjusted_hue_gap_half = adjusted_hue_gap / 2;
-//}
-//
-//// Frame update method
-//void PerlinFade::frame() {
-//    for (int i = 0; i < led_controller->num_led; i++) {
-//        uint32_t color = get_fire_color(inoise8(i * fire_step, counter));
-//
-//        // Extract red, green, and blue components
-//        uint8_t r = (color >> 16) & 0xFF;
-//        uint8_t g = (color >> 8) & 0xFF;
-//        uint8_t b = color & 0xFF;
-//
-//        // Set the color on the LED controller
-//        led_controller->set_pixel(i, r, g, b);
-//    }
-//    counter += 5;
-//}
-//
-//// Check if the effect is done (override the base class method)
-//bool PerlinFade::is_done() {
-//    // Assuming the effect is never done; implement your condition if needed
-//    return false;
-//}
-//
-//// Return the mode ID for this effect (override the base class method)
-//uint8_t PerlinFade::get_mode_id() {
-//    // Assign a unique ID for this mode
-//    return 3; // Example ID, change if needed
-//}
-//
-//// Get fire color based on value
-//long PerlinFade::get_fire_color(uint8_t val) {
-//    return led_controller->led_strip->ColorHSV(
-//        timer->get_current_value() - adjusted_hue_gap_half + map(val, 0, 255, 0, adjusted_hue_gap),
-//        constrain(map(val, 0, 255, max_sat, min_sat), 0, 255),
-//        constrain(map(val, 0, 255, min_bright, max_bright), 0, 255)
-//    );
-//}
+PerlinFade::PerlinFade(LedStrip* led_strip, uint8_t r, uint8_t g, uint8_t b)
+    : LedMode(led_strip)
+{
+    DBG_PRINTF(PerlinFade, "-> PerlinFade::PerlinFade(led_strip: %p, r: %u, g: %u, b: %u)\n", (void*)led_strip, r, g, b);
+    set_rgb({r, g, b});
+    DBG_PRINTLN(PerlinFade, "<- PerlinFade::PerlinFade()");
+}
+
+void PerlinFade::loop() {
+}
+
+bool PerlinFade::is_done() {
+    return false;
+}
+
+// noise value 0..255 maps to hue (set hue -+ HUE_GAP/2), saturation (high -> low) and
+// brightness (low -> high), so the bright spots are also the least saturated ones
+void PerlinFade::build_palette(uint8_t hue) {
+    DBG_PRINTF(PerlinFade, "-> PerlinFade::build_palette(hue: %u)\n", hue);
+    const uint8_t hue_start = hue - HUE_GAP / 2;
+    for (uint16_t v = 0; v < 256; v++) {
+        std::array<uint8_t, 3> rgb_out = LedMode::hsv_to_rgb({
+            static_cast<uint8_t>(hue_start + scale8(v, HUE_GAP)),
+            static_cast<uint8_t>(MAX_SAT - scale8(v, MAX_SAT - MIN_SAT)),
+            static_cast<uint8_t>(MIN_BRIGHT + scale8(v, MAX_BRIGHT - MIN_BRIGHT))
+        });
+        palette[v] = CRGB(rgb_out[0], rgb_out[1], rgb_out[2]);
+    }
+    palette_hue = hue;
+    palette_valid = true;
+    DBG_PRINTLN(PerlinFade, "<- PerlinFade::build_palette()");
+}
+
+// the time axis comes from the frame clock, so the speed does not depend on the frame rate.
+// 16 bit noise coordinates wrap on a lattice boundary, so the wrap of both axes is seamless
+void PerlinFade::render(std::span<CRGB> out, FrameContext& ctx) {
+    const uint8_t hue = get_h();
+    if (!palette_valid || hue != palette_hue) build_palette(hue);
+
+    const uint16_t z = static_cast<uint16_t>(ctx.now_us >> TIME_SHIFT);
+    uint16_t x = 0;
+    for (CRGB& pixel : out) {
+        pixel = palette[inoise8(x, z)];
+        x += FIRE_STEP;
+    }
+}
+
+bool PerlinFade::is_uniform() const {
+    return false;
+}
+
+const LedModeInfo& PerlinFade::get_info() const {
+    return INFO;
+}
+
+LedMode* PerlinFade::create(void* storage, LedStrip* led_strip, std::array<uint8_t, 3> rgb) {
+    return new (storage) PerlinFade(led_strip, rgb[0], rgb[1], rgb[2]);
+}
+
+// the set color is the target, the effect itself never settles
+std::array<uint8_t, 3> PerlinFade::get_target_rgb() {
+    return get_rgb();
+}
+
+uint8_t PerlinFade::get_target_r() {
+    return get_r();
+}
+
+uint8_t PerlinFade::get_target_g() {
+    return get_g();
+}
+
+uint8_t PerlinFade::get_target_b() {
+    return get_b();
+}
+
+std::array<uint8_t, 3> PerlinFade::get_target_hsv() {
+    return get_hsv();
+}
+
+uint8_t PerlinFade::get_target_h() {
+    return get_h();
+}
+
+uint8_t PerlinFade::get_target_s() {
+    return get_s();
+}
+
+uint8_t PerlinFade::get_target_v() {
+    return get_v();
+}
@@ -130,6 +130,111 @@ LedStrip::LedStrip(SystemController& controller)
             1,
             [this](std::string_view args){ set_length_cli(args); }
         });
+        commands_storage.push_back({
+            "seg_add",
+            "Add a segment: <start> <length> <reverse 0|1>",
+            std::string("Sample Use: $") + lower(module_name) + " seg_add 0 120 0",
+            3,
+            [this](std::string_view args){ seg_add_cli(args); }
+        });
+        commands_storage.push_back({
+            "seg_resize",
+            "Move/resize a segment: <id> <start> <length>",
+            std::string("Sample Use: $") + lower(module_name) + " seg_resize 0 10 100",
+            3,
+            [this](std::string_view args){ seg_resize_cli(args); }
+        });
+        commands_storage.push_back({
+            "seg_remove",
+            "Remove a segment by id",
+            std::string("Sample Use: $") + lower(module_name) + " seg_remove 0",
+            1,
+            [this](std::string_view args){ seg_remove_cli(args); }
+        });
+        commands_storage.push_back({
+            "seg_rgb",
+            "Set segment RGB color: <id> <r> <g> <b>",
+            std::string("Sample Use: $") + lower(module_name) + " seg_rgb 0 255 120 0",
+            4,
+            [this](std::string_view args){ seg_rgb_cli(args); }
+        });
+        commands_storage.push_back({
+            "seg_brightness",
+            "Set segment brightness: <id> <brightness>",
+            std::string("Sample Use: $") + lower(module_name) + " seg_brightness 0 128",
+            2,
+            [this](std::string_view args){ seg_brightness_cli(args); }
+        });
+        commands_storage.push_back({
+            "seg_mode",
+            "Set segment mode: <id> <mode id>",
+            std::string("Sample Use: $") + lower(module_name) + " seg_mode 0 2",
+            2,
+            [this](std::string_view args){ seg_mode_cli(args); }
+        });
+        commands_storage.push_back({
+            "seg_list",
+            "List segments",
+            std::string("Sample Use: $") + lower(module_name) + " seg_list",
+            0,
+            [this](std::string_view){ seg_list_cli(); }
+        });
+        commands_storage.push_back({
+            "pal_set",
+            "Define a palette: <slot> <position:RRGGBB,...>, up to 16 stops",
+            std::string("Sample Use: $") + lower(module_name) + " pal_set 0 0:FF0000,128:FFA000,255:000000",
+            2,
+            [this](std::string_view args){ pal_set_cli(args); }
+        });
+        commands_storage.push_back({
+            "pal_select",
+            "Select the palette used by palette modes",
+            std::string("Sample Use: $") + lower(module_name) + " pal_select 0",
+            1,
+            [this](std::string_view args){ pal_select_cli(args); }
+        });
+        commands_storage.push_back({
+            "pal_remove",
+            "Remove a palette",
+            std::string("Sample Use: $") + lower(module_name) + " pal_remove 0",
+            1,
+            [this](std::string_view args){ pal_remove_cli(args); }
+        });
+        commands_storage.push_back({
+            "pal_list",
+            "List palettes",
+            std::string("Sample Use: $") + lower(module_name) + " pal_list",
+            0,
+            [this](std::string_view){ pal_list_cli(); }
+        });
+        commands_storage.push_back({
+            "power_budget",
+            "Cap the estimated strip current in mA, 0 = unlimited",
+            std::string("Sample Use: $") + lower(module_name) + " power_budget 8000",
+            1,
+            [this](std::string_view args){ power_budget_cli(args); }
+        });
+        commands_storage.push_back({
+            "benchmark",
+            "Measure render cost of every mode against its frame budget",
+            std::string("Sample Use: $") + lower(module_name) + " benchmark",
+            0,
+            [this](std::string_view){ benchmark_cli(); }
+        });
+        commands_storage.push_back({
+            "stats",
+            "Frame time per stage: min, avg, p99, max and dropped frames",
+            std::string("Sample Use: $") + lower(module_name) + " stats",
+            0,
+            [this](std::string_view){ stats_cli(); }
+        });
+        commands_storage.push_back({
+            "stats_reset",
+            "Clear the frame time histograms",
+            std::string("Sample Use: $") + lower(module_name) + " stats_reset",
+            0,
+            [this](std::string_view){ stats_reset_cli(); }
+        });
         DBG_PRINTLN(LedStrip, "<- LedStrip::LedStrip()");
     }
 
@@ -143,6 +248,14 @@ LedStrip::~LedStrip() {
         vSemaphoreDelete(led_data_mutex);
         led_data_mutex = NULL;
     }
+    if (led_output_mutex != NULL) {
+        vSemaphoreDelete(led_output_mutex);
+        led_output_mutex = NULL;
+    }
+    if (output_done != NULL) {
+        vSemaphoreDelete(output_done);
+        output_done = NULL;
+    }
     DBG_PRINTLN(LedStrip, "LedStrip: Destructor called, mutexes deleted");
     DBG_PRINTLN(LedStrip, "<- LedStrip::~LedStrip()");
 }
@@ -162,18 +275,67 @@ void LedStrip::begin_routines_required (const ModuleConfig& cfg) {
     const auto& config = static_cast<const LedStripConfig&>(cfg);
     this->color_transition_delay = config.color_transition_delay;
     this->num_led                = config.num_led               ;
-
-    FastLED.addLeds<LED_STRIP_TYPE, PIN_LED_STRIP, LED_STRIP_COLOR_ORDER>(leds, LED_STRIP_NUM_LEDS_MAX).setCorrection( TypicalLEDStrip );
+    this->frame_delay_auto       = config.led_controller_frame_delay == 0;
+    this->led_controller_frame_delay = config.led_controller_frame_delay;
+    this->brightness_transition_delay = config.brightness_transition_delay;
+    this->color_easing           = config.color_easing;
+    this->brightness_easing      = config.brightness_easing;
+
+    if (!allocate_buffers(num_led)) {
+        controller.serial_port.printf("Not enough memory for %u LEDs\n", num_led);
+        num_led = 0;
+    }
+    add_channels();
     FastLED.setBrightness(255);
+    if (frame_delay_auto) led_controller_frame_delay = auto_frame_delay(num_led);
 
-    frame_timer = std::make_unique<AsyncTimer<uint8_t>>(config.led_controller_frame_delay);
-    brightness = std::make_unique<Brightness>(config.brightness_transition_delay, 0, 0);
-    led_mode = std::make_unique<ColorSolid>(this, 0, 0, 0);
+    brightness = std::make_unique<Brightness>(config.brightness_transition_delay, 0, 0, brightness_easing);
+    led_mode = &mode_slots[active_slot].emplace<ColorSolid>(this, 0, 0, 0);
+    crossfade_timer = std::make_unique<AsyncTimer<uint16_t>>(color_transition_delay, 0, 256, color_easing);
 
     led_mode_mutex = xSemaphoreCreateMutex();
     led_data_mutex = xSemaphoreCreateMutex();
+    led_output_mutex = xSemaphoreCreateMutex();
+
+    segments.reserve(LED_STRIP_SEGMENTS_MAX);
+    frame_segments.reserve(LED_STRIP_SEGMENTS_MAX);
+    last_frame_segments.reserve(LED_STRIP_SEGMENTS_MAX);
 
-    frame_timer->initiate();
+    // before the render task starts, it reads current_source without a lock
+    if (config.make_current_source) {
+        current_source = config.make_current_source();
+    }
+#ifdef PIN_STRIP_ISENSE
+    else {
+        current_source.reset(new (std::nothrow) AdcCurrentSource(PIN_STRIP_ISENSE,
+                                                                 LED_STRIP_ISENSE_MV_PER_A, LED_STRIP_ISENSE_OFFSET_MV,
+                                                                 LED_STRIP_ISENSE_SAMPLE_HZ, LED_STRIP_ISENSE_AVERAGE));
+    }
+#endif
+    if (current_source && !current_source->begin()) {
+        controller.serial_port.println("Current sense: source setup failed, using the estimated power limit only");
+        current_source.reset();
+    }
+
+    // the output task starts first, the renderer hands frames to it from its first frame on
+    if (config.output_task_enabled) {
+        output_done = xSemaphoreCreateBinary();
+        if (output_done) xSemaphoreGive(output_done);
+        if (!output_done || xTaskCreate(&LedStrip::output_task_entry, "led_output", config.output_task_stack_size,
+                                        this, config.output_task_priority, &output_task) != pdPASS) {
+            DBG_PRINTLN(LedStrip, "ERROR: Could not create output task, showing frames in the render context");
+            output_task = nullptr;
+        }
+    }
+
+    if (config.render_task_enabled) {
+        render_task_priority = config.render_task_priority;
+        if (xTaskCreate(&LedStrip::render_task_entry, "led_render", config.render_task_stack_size,
+                        this, render_task_priority, &render_task) != pdPASS) {
+            DBG_PRINTLN(LedStrip, "ERROR: Could not create render task, falling back to loop()");
+            render_task = nullptr;
+        }
+    }
 }
 
 void LedStrip::begin_routines_init (const ModuleConfig& cfg) {
@@ -205,6 +367,13 @@ void LedStrip::begin_routines_init (const ModuleConfig& cfg) {
 
 void LedStrip::begin_routines_regular (const ModuleConfig& cfg) {
     controller.nvs.sync_from_memory({true, false, false, false, false});
+    load_segments();
+    // a missing or broken selected palette keeps the built-in rainbow
+    palette_slot = controller.nvs.read_uint8(nvs_key, "pal_sel", 0);
+    apply_palette(controller.nvs.read_str(nvs_key, "pal_cfg_" + std::to_string(palette_slot)));
+    uint16_t power_budget = controller.nvs.read_uint16(nvs_key, "pwr_budget", LED_STRIP_POWER_BUDGET_MA);
+    power_limiter.set_budget_ma(power_budget);
+    current_limiter.set_budget_ma(power_budget);
 }
 
 void LedStrip::begin_routines_common (const ModuleConfig& cfg) {
@@ -215,23 +384,122 @@ void LedStrip::begin_routines_common (const ModuleConfig& cfg) {
 }
 
 void LedStrip::loop() {
-    if (frame_timer->is_active()) return;
-    frame_timer->reset();
-    frame_timer->initiate();
+    if (render_task) return;  // frames are produced by the render task
+    // without the task the frame is due led_controller_frame_delay after the last one, read fresh
+    // so a new strip length changes the pace at once
+    uint32_t now_ms = millis();
+    if (now_ms - last_frame_ms < led_controller_frame_delay) return;
+    if (render_idle && !render_wake_pending
+            && micros() - last_frame_start_us < LED_STRIP_IDLE_WAKE_MS * 1000UL) return;
+    last_frame_ms = now_ms;
+    render_wake_pending = false;
+    if (render_idle) last_frame_start_us = 0;  // a parked interval is not frame jitter
+    render_frame();
+}
+
+void LedStrip::render_task_entry(void* arg) {
+    static_cast<LedStrip*>(arg)->render_task_loop();
+}
+
+void LedStrip::render_task_loop() {
+    TickType_t last_wake = xTaskGetTickCount();
+    while (true) {
+        if (render_idle) {
+            // parked: the next frame starts on wake_render(), the period restarts from there
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LED_STRIP_IDLE_WAKE_MS));
+            last_wake           = xTaskGetTickCount();
+            last_frame_start_us = 0;
+        } else {
+            TickType_t period = pdMS_TO_TICKS(led_controller_frame_delay);
+            vTaskDelayUntil(&last_wake, period > 0 ? period : 1);
+        }
+        render_wake_pending = false;
+        uint32_t start_us = micros();
+        render_frame();
+        render_busy_us += micros() - start_us;
+    }
+}
+
+void LedStrip::output_task_entry(void* arg) {
+    static_cast<LedStrip*>(arg)->output_task_loop();
+}
+
+// blocks in FastLED.show() while the RMT clocks the frame out, the render task runs meanwhile
+void LedStrip::output_task_loop() {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint32_t start_us = micros();
+        if (xSemaphoreTake(led_output_mutex, portMAX_DELAY) == pdTRUE) {
+            // set_length may have reallocated since the frame was published, the new pair was never written
+            uint16_t output_length = published_generation == buffer_generation
+                                     ? std::min(output_length_pending.load(), buffer_capacity) : 0;
+            if (output_length > 0) {
+                bind_channels(led_buffers[front_buffer.load(std::memory_order_acquire)].get(), output_length);
+                FastLED.show();
+                output_show_us = micros() - start_us;
+            }
+            xSemaphoreGive(led_output_mutex);
+        } else {
+            DBG_PRINTLN(LedStrip, "ERROR: Could not take led_output_mutex in output_task_loop");
+        }
+        xSemaphoreGive(output_done);
+    }
+}
+
+void LedStrip::wake_render() {
+    render_wake_pending = true;
+    if (render_task) xTaskNotifyGive(render_task);
+}
 
-    std::array<uint8_t, 3> color_to_fill = {0, 0, 0};
+void LedStrip::render_frame() {
+    uint32_t frame_start_us = micros();
+    if (last_frame_start_us != 0) {
+        uint32_t period_us = static_cast<uint32_t>(led_controller_frame_delay) * 1000;
+        uint32_t actual_us = frame_start_us - last_frame_start_us;
+        uint32_t jitter_us = actual_us > period_us ? actual_us - period_us : period_us - actual_us;
+        jitter_max_us  = std::max(jitter_max_us, jitter_us);
+        jitter_sum_us += jitter_us;
+        jitter_samples++;
+#if LED_STRIP_FRAME_STATS
+        frame_stats.record_interval(actual_us, period_us);
+#endif
+    }
+#if LED_STRIP_FRAME_STATS
+    stage_mark_us = frame_start_us;
+#endif
+    if (frame_start_us - fps_window_start_us >= 1000000) {
+        fps_achieved        = fps_window_frames;
+        fps_window_frames   = 0;
+        fps_window_start_us = frame_start_us;
+    }
+    fps_window_frames++;
+    frame_context.delta_us = last_frame_start_us != 0 ? frame_start_us - last_frame_start_us : 0;
+    frame_context.now_us   = frame_start_us;
+    frame_context.frame_index++;
+    last_frame_start_us = frame_start_us;
+
+    CRGB16 color_to_fill = {0, 0, 0};
     bool needs_mode_reassignment = false;
-    uint8_t current_mode_id_local = COLOR_SOLID;
+    uint8_t current_mode_id_local = ColorSolid::INFO.id;
     std::array<uint8_t, 3> rgb_temp_for_reassign = {0, 0, 0};
+    BrightnessFrame frame_brightness = brightness ? brightness->get_frame() : BrightnessFrame{};
+
+    // a new current reading moves the trim, a solid frame then has to be pushed again
+    uint32_t sensed_ma = 0;
+    if (current_source && current_source->read_ma(sensed_ma)) {
+        uint32_t trim = current_limiter.get_trim_q16();
+        current_limiter.set_idle_ma(std::min<uint32_t>(LED_STRIP_ISENSE_BASE_MA + num_led * LED_STRIP_IDLE_MA, UINT16_MAX));
+        if (current_limiter.update(sensed_ma) != trim) frame_dirty.store(true);
+    }
 
     if (xSemaphoreTake(led_mode_mutex, (TickType_t)10) == pdTRUE) {
         if (led_mode) {
             led_mode->loop();
 
             current_mode_id_local = led_mode->get_mode_id();
-            color_to_fill = led_mode->get_rgb();
+            color_to_fill = led_mode->get_rgb16();
 
-            if (current_mode_id_local == COLOR_CHANGING) {
+            if (current_mode_id_local == ColorChanging::INFO.id) {
                 if (led_mode->is_done()) {
                     needs_mode_reassignment = true;
                     rgb_temp_for_reassign = led_mode->get_rgb();
@@ -239,14 +507,76 @@ void LedStrip::loop() {
             }
 
             if (needs_mode_reassignment) {
-                led_mode = std::make_unique<ColorSolid>(this, rgb_temp_for_reassign[0], rgb_temp_for_reassign[1], rgb_temp_for_reassign[2]);
-                color_to_fill = led_mode->get_rgb();
+                led_mode = &mode_slots[active_slot].emplace<ColorSolid>(this, rgb_temp_for_reassign[0], rgb_temp_for_reassign[1], rgb_temp_for_reassign[2]);
+                color_to_fill = led_mode->get_rgb16();
             }
         }
+        frame_segments.clear();
+        bool segments_uniform = true;
+        for (auto& segment : segments) {
+            segment->loop();
+            frame_segments.push_back(segment->get_frame(frame_brightness));
+            segments_uniform = segments_uniform && frame_segments.back().uniform;
+        }
+        stage_done(FrameStage::UPDATE);
+
+        // spatial modes and crossfades render per pixel while the mode mutex is held,
+        // the frame is shown after it is released
+        uint16_t rendered_length = 0;
+        uint32_t rendered_generation = 0;
+        bool rendered = false;
+        if (outgoing_mode && crossfade_timer->is_done()) {
+            mode_slots[active_slot ^ 1].reset();
+            outgoing_mode = nullptr;
+            frame_dirty.store(true);
+        }
+        if (outgoing_mode || (led_mode && !led_mode->is_uniform()) || !segments_uniform) {
+            if (outgoing_mode) outgoing_mode->loop();
+            uint16_t amount = outgoing_mode ? crossfade_timer->get_current_value() : 256;
+            rendered_length = compose_rendered_frame(frame_brightness, amount, frame_segments, rendered_generation);
+            rendered = true;
+        }
+        bool scene_static = !rendered && led_mode && led_mode->is_static()
+                            && !(brightness && brightness->is_transitioning());
+        for (auto& segment : segments) scene_static = scene_static && segment->is_static();
         xSemaphoreGive(led_mode_mutex);
-        this->fill_all(color_to_fill); // this should happen in the led mode to avoid show when there is no change in color
+
+        // the frame is fully described by the output base level, the segment levels and the length,
+        // so only render and show when one of them moved since the last push. a dithered frame
+        // has to be pushed every frame
+        // taken before the frame is composed: a setter that marks it dirty from now on is seen next frame
+        bool dirty = frame_dirty.exchange(false);
+        CRGB16 frame_level = output_level_q8(color_to_fill, frame_brightness);
+        if (rendered) {
+            if (rendered_length > 0 && publish_frame(rendered_generation)) show_frame(rendered_length);
+            frame_dirty.store(true);
+            frames_pushed++;
+        } else if (!dirty && frame_level == last_frame_level
+                && num_led == last_frame_length && frame_segments == last_frame_segments) {
+            frames_skipped++;
+        } else {
+            settle_output = scene_static;
+            bool dithered = compose_frame(frame_level, frame_segments);
+            last_frame_level  = frame_level;
+            last_frame_length = num_led;
+            std::swap(frame_segments, last_frame_segments);
+            if (dithered) frame_dirty.store(true);
+            frames_pushed++;
+        }
+        // a setter that ran during this frame leaves render_wake_pending set and keeps the task awake
+        render_idle = scene_static && !frame_dirty.load() && !render_wake_pending;
     }
-    fps_counter++;
+#if LED_STRIP_FRAME_STATS
+    frame_stats.record(FrameStage::FRAME, micros() - frame_start_us);
+#endif
+}
+
+void LedStrip::stage_done(FrameStage stage) {
+#if LED_STRIP_FRAME_STATS
+    uint32_t now_us = micros();
+    frame_stats.record(stage, now_us - stage_mark_us);
+    stage_mark_us = now_us;
+#endif
 }
 
 void LedStrip::reset (const bool verbose, const bool do_restart) {
@@ -258,6 +588,11 @@ void LedStrip::reset (const bool verbose, const bool do_restart) {
         this->num_led,
         {true, true, true, true, true}
     );
+    if (xSemaphoreTake(led_mode_mutex, portMAX_DELAY) == pdTRUE) {
+        segments.clear();
+        xSemaphoreGive(led_mode_mutex);
+    }
+    save_segments();
     if (verbose) status(true);
     Module::reset(verbose, do_restart);
 }
@@ -268,17 +603,58 @@ std::string LedStrip::status (const bool verbose) const {
                   << "|                LED Strip Status                |\n"
                   << "+------------------------------------------------+\n"
                   << "Hardware Config (firmware):\n"
-                  << "    Pin:          GPIO" << static_cast<int>(PIN_LED_STRIP) << "\n"
+                  << "    Pin:          GPIO" << static_cast<int>(PIN_LED_STRIP)
+#ifdef PIN_LED_STRIP_2
+                  << ", GPIO" << static_cast<int>(PIN_LED_STRIP_2)
+#endif
+#ifdef PIN_LED_STRIP_3
+                  << ", GPIO" << static_cast<int>(PIN_LED_STRIP_3)
+#endif
+#ifdef PIN_LED_STRIP_4
+                  << ", GPIO" << static_cast<int>(PIN_LED_STRIP_4)
+#endif
+                  << "\n"
+                  << "    Channels:     " << LED_STRIP_CHANNELS << " x " << channel_length(0, num_led) << " LEDs max\n"
                   << "    Type:         " << TO_STRING(LED_STRIP_TYPE) << "\n"
                   << "    Color Order:  " << TO_STRING(LED_STRIP_COLOR_ORDER) << "\n"
                   << "    Max LEDs:     " << LED_STRIP_NUM_LEDS_MAX << "\n"
+                  << "    Buffer:       " << buffer_capacity << " LEDs x3 (" << 3 * sizeof(CRGB) * buffer_capacity << " bytes)\n"
+                  << "    Gamma:        " << LED_STRIP_GAMMA_R << "/" << LED_STRIP_GAMMA_G << "/" << LED_STRIP_GAMMA_B
+                  << " (x100), white balance " << LED_STRIP_WHITE_BALANCE_R << "/" << LED_STRIP_WHITE_BALANCE_G
+                  << "/" << LED_STRIP_WHITE_BALANCE_B << "\n"
+                  << "    Dithering:    " << (LED_STRIP_DITHER ? "temporal, 8.8 output" : "off") << "\n"
+                  << "    Mode slots:   2 x " << StripModeSlot::CAPACITY << " bytes\n"
                   << "\n"
                   << "Live State:\n"
-                  << "    FPS:          " << fps_counter * 1000 / millis()  << "\n"
+                  << "    FPS:          target " << (led_controller_frame_delay ? 1000 / led_controller_frame_delay : 0)
+                  << ", achieved " << fps_achieved << " (wire " << wire_time_us(num_led) << " us per frame)\n"
+                  << "    Frames:       " << frames_pushed << " pushed, " << frames_skipped << " skipped\n"
+                  << "    Render:       " << (render_task ? "task (priority " + std::to_string(render_task_priority) + ")" : std::string("main loop"))
+                  << ", " << static_cast<int>(led_controller_frame_delay) << " ms period"
+                  << (frame_delay_auto ? " (auto)" : "") << (render_idle ? ", parked" : "") << "\n"
+                  << "    Output:       " << (output_task ? "task, overlaps the next render" : "in the render context") << "\n"
+                  << "    Easing:       color " << easing_name(color_easing)
+                  << ", brightness " << easing_name(brightness_easing) << "\n"
+                  << "    Jitter:       avg " << (jitter_samples ? jitter_sum_us / jitter_samples : 0)
+                  << " us, max " << jitter_max_us << " us\n"
                   << "    Length:       " << get_length() << "\n"
+                  << "    Segments:     " << static_cast<int>(get_segment_count()) << "/" << LED_STRIP_SEGMENTS_MAX << "\n"
+                  << "    Palette:      slot " << static_cast<int>(palette_slot) << ", "
+                  << static_cast<int>(palette.get_stop_count()) << " stops\n"
+                  << "    Power:        " << power_limiter.get_estimated_ma() << " mA estimated, "
+                  << power_limiter.get_limited_ma() << " mA shown, budget "
+                  << (get_power_budget() ? std::to_string(get_power_budget()) + " mA" : std::string("unlimited"))
+                  << ", " << power_limiter.get_limited_frames() << " frames limited\n"
+                  << "    Current:      "
+                  << (current_source ? std::to_string(current_limiter.get_sample_ma()) + " mA measured, trim "
+                                       + std::to_string(current_limiter.get_trim_q16() * 100 / CurrentLimiter::TRIM_ONE) + "%"
+                                     : std::string("no sense pin")) << "\n"
                   << "    State:        " << (get_state() ? "ON" : "OFF") << "\n"
                   << "    Brightness:   " << static_cast<int>(get_brightness()) << "\n"
-                  << "    Mode:         " << get_mode_name().c_str() << "\n"
+                  << "    Mode:         " << get_mode_name() << (outgoing_mode ? " (crossfading)" : "") << "\n"
+                  << "    Mode changes: " << led_mode_slot_stats.switches.load() << ", "
+                  << led_mode_slot_stats.switch_allocations.load() << " heap allocs ("
+                  << allocation_count() << " system wide)\n"
                   << "    Color (RGB):  ("
                   << static_cast<int>(get_r()) << ", "
                   << static_cast<int>(get_g()) << ", "
@@ -300,27 +676,29 @@ void LedStrip::set_mode(uint8_t new_mode_id) {
             current_rgb = led_mode->get_rgb();
         }
 
-        switch (static_cast<LedModeID>(new_mode_id)) {
-            case COLOR_SOLID:
-                // When switching to solid, use the current color of the previous mode
-                led_mode = std::make_unique<ColorSolid>(this, current_rgb[0], current_rgb[1], current_rgb[2]);
-                break;
-            // Add cases for other modes, e.g.,
-            // case COLOR_CHANGING:
-            //     // Requires a target color; perhaps set_rgb should be used for this.
-            //     // Or, this set_mode could transition to a default ColorChanging effect.
-            //     led_mode = std::make_unique<ColorChanging>(this, current_rgb[0], current_rgb[1], current_rgb[2], /*target r*/255, /*target g*/0, /*target b*/0, 'r', color_transition_delay);
-            //     break;
-            default:
-                DBG_PRINTF(LedStrip, "set_mode: Unknown mode ID %u\n", new_mode_id);
-                // Optionally, revert to a default mode or do nothing
-                led_mode = std::make_unique<ColorSolid>(this, current_rgb[0], current_rgb[1], current_rgb[2]); // Revert to solid with current color
-                break;
+        // the new mode starts from the current color of the previous one
+        const LedModeInfo* info = find_led_mode(new_mode_id);
+        if (!info || !info->create) {
+            DBG_PRINTF(LedStrip, "set_mode: Unknown mode ID %u\n", new_mode_id);
+            info = &ColorSolid::INFO;
+        }
+        // a different mode fades in over the previous one instead of replacing it on the next frame.
+        // it is built in the other slot, which drops the older outgoing mode of a running crossfade
+        bool crossfade = led_mode && led_mode->get_mode_id() != info->id && color_transition_delay > 0;
+        if (crossfade) {
+            outgoing_mode = led_mode;
+            active_slot ^= 1;
+        }
+        led_mode = mode_slots[active_slot].emplace(*info, this, current_rgb);
+        if (crossfade) {
+            crossfade_timer->reset(color_transition_delay, 0, 256);
+            crossfade_timer->initiate();
         }
         xSemaphoreGive(led_mode_mutex);
     } else {
         DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in set_mode");
     }
+    wake_render();
     DBG_PRINTLN(LedStrip, "<- LedStrip::set_mode()");
 }
 
@@ -339,12 +717,12 @@ void LedStrip::set_rgb(std::array<uint8_t, 3> new_rgb) {
         DBG_PRINTF(LedStrip, "Current mode ID is %u.\n", current_mode_id);
 
         // Check if the target color is already set, depending on the current mode
-        if (current_mode_id == COLOR_SOLID) {
+        if (current_mode_id == ColorSolid::INFO.id) {
             DBG_PRINTLN(LedStrip, "Mode is SOLID. Comparing new target to current color.");
             if (old_rgb == new_rgb) {
                 already_set = true;
             }
-        } else if (current_mode_id == COLOR_CHANGING) {
+        } else if (current_mode_id == ColorChanging::INFO.id) {
             DBG_PRINTLN(LedStrip, "Mode is CHANGING. Comparing new target to existing target color.");
             std::array<uint8_t, 3> target_rgb = led_mode->get_target_rgb();
             DBG_PRINTF(LedStrip, "Existing target color is R=%u G=%u B=%u\n", target_rgb[0], target_rgb[1], target_rgb[2]);
@@ -361,6 +739,14 @@ void LedStrip::set_rgb(std::array<uint8_t, 3> new_rgb) {
             return;
         }
 
+        // spatial modes keep running and take the new color as their base
+        if (!led_mode->is_uniform()) {
+            led_mode->set_rgb(new_rgb);
+            xSemaphoreGive(led_mode_mutex);
+            DBG_PRINTLN(LedStrip, "<- LedStrip::set_rgb() (spatial mode recolored)");
+            return;
+        }
+
         DBG_PRINTLN(LedStrip, "New color is different. Creating a new ColorChanging mode for transition.");
         DBG_PRINTF(LedStrip, "Transitioning from {%u, %u, %u} to {%u, %u, %u} with delay %u.\n",
                    old_rgb[0], old_rgb[1], old_rgb[2],
@@ -368,18 +754,20 @@ void LedStrip::set_rgb(std::array<uint8_t, 3> new_rgb) {
                    color_transition_delay);
 
         // Start a new transition from the current actual color (old_rgb) to the new target
-        led_mode = std::make_unique<ColorChanging>(
+        led_mode = &mode_slots[active_slot].emplace<ColorChanging>(
             this,
             old_rgb[0], old_rgb[1], old_rgb[2], // Start color
             new_rgb[0], new_rgb[1], new_rgb[2], // Target color
             'r',                               // RGB mode for ColorChanging
-            color_transition_delay);
+            color_transition_delay,
+            color_easing);
 
         DBG_PRINTLN(LedStrip, "New mode created. Releasing led_mode_mutex...");
         xSemaphoreGive(led_mode_mutex);
     } else {
         DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in set_rgb");
     }
+    wake_render();
     DBG_PRINTLN(LedStrip, "<- LedStrip::set_rgb()");
 }
 
@@ -447,9 +835,9 @@ void LedStrip::set_hsv(std::array<uint8_t, 3> new_hsv) {
             current_hsv_val = led_mode->get_hsv();
             current_rgb_for_transition = led_mode->get_rgb();
 
-            if (led_mode->get_mode_id() == COLOR_SOLID && current_hsv_val == new_hsv) {
+            if (led_mode->get_mode_id() == ColorSolid::INFO.id && current_hsv_val == new_hsv) {
                  already_set = true;
-            } else if (led_mode->get_mode_id() == COLOR_CHANGING) {
+            } else if (led_mode->get_mode_id() == ColorChanging::INFO.id) {
                 std::array<uint8_t, 3> target_hsv = led_mode->get_target_hsv();
                 if (target_hsv == new_hsv) {
                     already_set = true;
@@ -464,17 +852,26 @@ void LedStrip::set_hsv(std::array<uint8_t, 3> new_hsv) {
             return;
         }
 
-        led_mode = std::make_unique<ColorChanging>(
+        if (led_mode && !led_mode->is_uniform()) {
+            led_mode->set_hsv(new_hsv);
+            xSemaphoreGive(led_mode_mutex);
+            DBG_PRINTLN(LedStrip, "<- LedStrip::set_hsv() (spatial mode recolored)");
+            return;
+        }
+
+        led_mode = &mode_slots[active_slot].emplace<ColorChanging>(
             this,
             current_rgb_for_transition[0], current_rgb_for_transition[1], current_rgb_for_transition[2],
             new_hsv[0], new_hsv[1], new_hsv[2],
             'h', // HSV mode for ColorChanging
-            color_transition_delay);
+            color_transition_delay,
+            color_easing);
 
         xSemaphoreGive(led_mode_mutex);
     } else {
         DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in set_hsv");
     }
+    wake_render();
     DBG_PRINTLN(LedStrip, "<- LedStrip::set_hsv()");
 }
 
@@ -534,6 +931,7 @@ void LedStrip::set_brightness(uint8_t new_brightness) {
     if (brightness) {
         brightness->set_brightness(new_brightness);
     }
+    wake_render();
     DBG_PRINTLN(LedStrip, "<- LedStrip::set_brightness()");
 }
 
@@ -560,6 +958,7 @@ void LedStrip::turn_on() {
     if (brightness) {
         brightness->turn_on();
     }
+    wake_render();
     DBG_PRINTLN(LedStrip, "<- LedStrip::turn_on()");
 }
 
@@ -568,36 +967,333 @@ void LedStrip::turn_off() {
     if (brightness) {
         brightness->turn_off();
     }
+    wake_render();
     DBG_PRINTLN(LedStrip, "<- LedStrip::turn_off()");
 }
 
-void LedStrip::fill_all(std::array<uint8_t, 3> color_rgb) {
-//    DBG_PRINTF(LedStrip, "-> LedStrip::fill_all(color_rgb: {%u, %u, %u})\n", color_rgb[0], color_rgb[1], color_rgb[2]);
+// dimmed and gamma corrected level of every channel in 8.8 fixed point. without dithering it is rounded
+// to whole steps here, so a solid frame is still one fill_solid and is skipped while it does not change
+CRGB16 LedStrip::output_level_q8(CRGB16 color_q8, const BrightnessFrame& frame_brightness) {
+    CRGB16 level = {gamma_correct_q8(GAMMA_R, frame_brightness.apply_q8(color_q8[0])),
+                    gamma_correct_q8(GAMMA_G, frame_brightness.apply_q8(color_q8[1])),
+                    gamma_correct_q8(GAMMA_B, frame_brightness.apply_q8(color_q8[2]))};
+#if !LED_STRIP_DITHER
+    for (uint16_t& channel : level) channel = static_cast<uint16_t>(dither_quantize(channel, 128) << 8);
+#endif
+    return level;
+}
+
+// fills [from, to) with an output level: one fill_solid for a whole level, dithered per pixel otherwise
+// (rounded to nearest, the same every frame, without LED_STRIP_DITHER or on a static frame).
+// returns true when the range was dithered
+bool LedStrip::fill_level(CRGB* buffer, uint16_t from, uint16_t to, const CRGB16& level) const {
+    if (((level[0] | level[1] | level[2]) & 0xFF) == 0) {
+        fill_solid(buffer + from, to - from, CRGB(level[0] >> 8, level[1] >> 8, level[2] >> 8));
+        return false;
+    }
+    for (uint16_t i = from; i < to; i++) {
+        uint8_t threshold = settle_output ? 128 : output_threshold(frame_context.frame_index, i);
+        buffer[i] = CRGB(dither_quantize(level[0], threshold),
+                         dither_quantize(level[1], threshold),
+                         dither_quantize(level[2], threshold));
+    }
+    return LED_STRIP_DITHER && !settle_output && from < to;
+}
+
+// writes every pixel exactly once: gaps get the base level, segments their own level.
+// every color is gamma corrected once, not per pixel. segment_frames are sorted by start and never overlap,
+// anything past num_led is clipped. returns true when any part of the frame was dithered
+bool LedStrip::compose_frame(CRGB16 base_level, const std::vector<SegmentFrame>& segment_frames) {
+    uint16_t output_length = 0;
+    uint32_t generation = 0;
+    bool dithered = false;
     if (xSemaphoreTake(led_data_mutex, portMAX_DELAY) == pdTRUE) {
-        for (uint16_t i = 0; i < num_led; i++) {
-            set_pixel(i, color_rgb);
+        CRGB* buffer = back_buffer();
+        output_length = num_led;
+        generation = buffer_generation;
+        // the draw of a solid frame is known before it is written, so it is limited in the same frame
+        std::array<uint32_t, 3> level_sum = {0, 0, 0};
+        auto add_draw = [&](const CRGB16& level, uint16_t count) {
+            for (size_t c = 0; c < 3; c++) level_sum[c] += static_cast<uint32_t>(level[c]) * count;
+        };
+        uint16_t position = 0;
+        for (const SegmentFrame& segment_frame : segment_frames) {
+            if (segment_frame.start >= output_length) break;
+            uint16_t segment_end = std::min<uint16_t>(segment_frame.start + segment_frame.length, output_length);
+            add_draw(base_level, segment_frame.start - position);
+            add_draw(output_level_q8(segment_frame.level, BrightnessFrame{}), segment_end - segment_frame.start);
+            position = segment_end;
         }
-        if (num_led > 0) {
-            FastLED.show();
+        add_draw(base_level, output_length - position);
+        power_scale_q16 = power_limiter.limit_scale_q16(level_sum, output_length);
+        uint32_t scale = output_scale_q16();
+        auto limit = [scale](const CRGB16& level) -> CRGB16 {
+            return {PowerLimiter::apply(level[0], scale), PowerLimiter::apply(level[1], scale),
+                    PowerLimiter::apply(level[2], scale)};
+        };
+
+        CRGB16 limited_base = limit(base_level);
+        position = 0;
+        for (const SegmentFrame& segment_frame : segment_frames) {
+            if (segment_frame.start >= output_length) break;
+            uint16_t segment_end = std::min<uint16_t>(segment_frame.start + segment_frame.length, output_length);
+            dithered |= fill_level(buffer, position, segment_frame.start, limited_base);
+            // segment levels are already dimmed, only the gamma step is left
+            dithered |= fill_level(buffer, segment_frame.start, segment_end,
+                                   limit(output_level_q8(segment_frame.level, BrightnessFrame{})));
+            position = segment_end;
         }
+        dithered |= fill_level(buffer, position, output_length, limited_base);
+        stage_done(FrameStage::CORRECTION);
         xSemaphoreGive(led_data_mutex);
     } else {
-        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_data_mutex in fill_all");
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_data_mutex in compose_frame");
+    }
+    if (output_length > 0 && publish_frame(generation)) show_frame(output_length);
+    return dithered;
+}
+
+// pins are template arguments in FastLED, so every channel needs its own addLeds call.
+// on ESP32 each controller gets an RMT channel and FastLED.show() starts them all before waiting
+void LedStrip::add_channels() {
+    CRGB* buffer = led_buffers[0].get();
+    channels[0] = &FastLED.addLeds<LED_STRIP_TYPE, PIN_LED_STRIP, LED_STRIP_COLOR_ORDER>(
+        buffer + channel_offset(0, num_led), channel_length(0, num_led));
+#ifdef PIN_LED_STRIP_2
+    channels[1] = &FastLED.addLeds<LED_STRIP_TYPE, PIN_LED_STRIP_2, LED_STRIP_COLOR_ORDER>(
+        buffer + channel_offset(1, num_led), channel_length(1, num_led));
+#endif
+#ifdef PIN_LED_STRIP_3
+    channels[2] = &FastLED.addLeds<LED_STRIP_TYPE, PIN_LED_STRIP_3, LED_STRIP_COLOR_ORDER>(
+        buffer + channel_offset(2, num_led), channel_length(2, num_led));
+#endif
+#ifdef PIN_LED_STRIP_4
+    channels[3] = &FastLED.addLeds<LED_STRIP_TYPE, PIN_LED_STRIP_4, LED_STRIP_COLOR_ORDER>(
+        buffer + channel_offset(3, num_led), channel_length(3, num_led));
+#endif
+    // no setCorrection: white balance is part of the gamma tables applied while composing the frame
+}
+
+// time FastLED needs to clock out one frame: the longest channel slice plus the latch
+uint32_t LedStrip::wire_time_us(uint16_t length) {
+    return static_cast<uint32_t>(channel_length(0, length)) * 24 * LED_STRIP_BIT_NS / 1000 + LED_STRIP_RESET_US;
+}
+
+// shortest whole ms interval that leaves LED_STRIP_FRAME_HEADROOM percent of it free after the wire time,
+// never shorter than the LED_STRIP_FPS_MAX period. 600 LEDs on one channel: 18.3 ms on the wire, 23 ms frames
+uint8_t LedStrip::auto_frame_delay(uint16_t length) {
+    uint32_t busy_us  = wire_time_us(length) * (100 + LED_STRIP_FRAME_HEADROOM) / 100;
+    uint32_t delay_ms = std::max<uint32_t>((busy_us + 999) / 1000, (1000 + LED_STRIP_FPS_MAX - 1) / LED_STRIP_FPS_MAX);
+    return static_cast<uint8_t>(std::min<uint32_t>(delay_ms, UINT8_MAX));
+}
+
+// caller holds led_data_mutex; the render task and the loop() fallback pick the new period up on their next frame
+void LedStrip::update_frame_delay() {
+    if (!frame_delay_auto) return;
+    led_controller_frame_delay = auto_frame_delay(num_led);
+    DBG_PRINTF(LedStrip, "Frame delay set to %u ms\n", led_controller_frame_delay);
+}
+
+// caller holds led_output_mutex
+void LedStrip::bind_channels(CRGB* buffer, uint16_t length) {
+    for (uint8_t i = 0; i < LED_STRIP_CHANNELS; i++) {
+        channels[i]->setLeds(buffer + channel_offset(i, length), channel_length(i, length));
     }
-//    DBG_PRINTLN(LedStrip, "<- LedStrip::fill_all()");
 }
 
-void LedStrip::set_pixel (uint16_t i, std::array<uint8_t, 3> color_rgb) {
-//    DBG_PRINTF(LedStrip, "-> LedStrip::set_pixel(i: %u, color_rgb: {%u, %u, %u})\n", i, color_rgb[0], color_rgb[1], color_rgb[2]);
-    if (leds && i < num_led) {
-        if (brightness) {
-            std::array<uint8_t, 3> dimmed_color = brightness->get_dimmed_color(color_rgb);
-            leds[i] = CRGB(dimmed_color[0], dimmed_color[1], dimmed_color[2]);
+// equal slices, the first (length % channels) channels take one extra LED
+uint16_t LedStrip::channel_offset(uint8_t channel, uint16_t length) {
+    uint16_t base = length / LED_STRIP_CHANNELS;
+    uint16_t extra = length % LED_STRIP_CHANNELS;
+    return channel * base + std::min<uint16_t>(channel, extra);
+}
+
+uint16_t LedStrip::channel_length(uint8_t channel, uint16_t length) {
+    return length / LED_STRIP_CHANNELS + (channel < length % LED_STRIP_CHANNELS ? 1 : 0);
+}
+
+// caller holds led_mode_mutex. the mode renders into the back buffer (and during a crossfade the
+// outgoing one into fade_buffer), then output_range() takes every base pixel to the output in one pass;
+// segments are written on top in the same walk. returns the length to show
+uint16_t LedStrip::compose_rendered_frame(const BrightnessFrame& frame_brightness, uint16_t amount,
+                                          const std::vector<SegmentFrame>& segment_frames, uint32_t& generation) {
+    uint16_t output_length = 0;
+    if (xSemaphoreTake(led_data_mutex, portMAX_DELAY) == pdTRUE) {
+        CRGB* buffer = back_buffer();
+        CRGB* fade = outgoing_mode ? fade_buffer.get() : nullptr;
+        output_length = num_led;
+        generation = buffer_generation;
+        led_mode->render(std::span<CRGB>(buffer, output_length), frame_context);
+        if (fade) outgoing_mode->render(std::span<CRGB>(fade, output_length), frame_context);
+        // segment_frames follows segments one to one, the caller holds led_mode_mutex
+        for (size_t i = 0; i < segment_frames.size(); i++) {
+            const SegmentFrame& segment_frame = segment_frames[i];
+            if (segment_frame.start >= output_length) break;
+            if (segment_frame.uniform) continue;
+            uint16_t segment_end = std::min<uint16_t>(segment_frame.start + segment_frame.length, output_length);
+            segments[i]->render(std::span<CRGB>(buffer + segment_frame.start, segment_end - segment_frame.start),
+                                frame_context);
+        }
+        stage_done(FrameStage::RENDER);
+
+        // the draw is only known once the pass is done, so it sets the power scale of the next rendered frame
+        std::array<uint32_t, 3> level_sum = {0, 0, 0};
+        uint32_t frame_index = frame_context.frame_index;
+        uint32_t scale = output_scale_q16();
+        uint16_t position = 0;
+        for (const SegmentFrame& segment_frame : segment_frames) {
+            if (segment_frame.start >= output_length) break;
+            uint16_t segment_end = std::min<uint16_t>(segment_frame.start + segment_frame.length, output_length);
+            output_range(buffer, fade, amount, frame_brightness, scale, frame_index,
+                         position, segment_frame.start, level_sum);
+            position = segment_end;
+            // segments are drawn over the strip mode, so the crossfade of the strip mode does not reach them
+            if (!segment_frame.uniform) {
+                output_range(buffer, nullptr, 256, segment_frame.brightness, scale, frame_index,
+                             segment_frame.start, segment_end, level_sum);
+                continue;
+            }
+            CRGB16 level = output_level_q8(segment_frame.level, BrightnessFrame{});
+            for (size_t c = 0; c < 3; c++) {
+                level_sum[c] += static_cast<uint32_t>(level[c]) * (segment_end - segment_frame.start);
+                level[c] = PowerLimiter::apply(level[c], scale);
+            }
+            fill_level(buffer, segment_frame.start, segment_end, level);
+        }
+        output_range(buffer, fade, amount, frame_brightness, scale, frame_index,
+                     position, output_length, level_sum);
+        power_scale_q16 = power_limiter.limit_scale_q16(level_sum, output_length);
+        stage_done(FrameStage::CORRECTION);
+        xSemaphoreGive(led_data_mutex);
+    } else {
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_data_mutex in compose_rendered_frame");
+    }
+    return output_length;
+}
+
+// power limit scale of the last estimate, trimmed by the measured current when a current sense is fitted
+uint32_t LedStrip::output_scale_q16() const {
+    return static_cast<uint32_t>((static_cast<uint64_t>(power_scale_q16) * current_limiter.get_trim_q16()) >> 16);
+}
+
+// takes [from, to) of a rendered frame to the output in place: crossfade blend, brightness, gamma and the
+// power limit all stay in 8.8 fixed point, the only rounding to 8 bits is the final quantize (dithered with
+// LED_STRIP_DITHER). level_sum collects the output levels before the power limit
+void LedStrip::output_range(CRGB* buffer, const CRGB* fade, uint16_t amount, const BrightnessFrame& frame_brightness,
+                            uint32_t power_scale_q16, uint32_t frame_index, uint16_t from, uint16_t to,
+                            std::array<uint32_t, 3>& level_sum) {
+    auto output = [&](const std::array<uint8_t, 256>& table, uint16_t value_q8, uint8_t threshold,
+                      uint32_t& channel_sum) -> uint8_t {
+        uint16_t level = gamma_correct_q8(table, frame_brightness.apply_q8(value_q8));
+        channel_sum += level;
+        return dither_quantize(PowerLimiter::apply(level, power_scale_q16), threshold);
+    };
+    if (!fade) {
+        for (uint16_t i = from; i < to; i++) {
+            uint8_t threshold = output_threshold(frame_index, i);
+            buffer[i].r = output(GAMMA_R, buffer[i].r << 8, threshold, level_sum[0]);
+            buffer[i].g = output(GAMMA_G, buffer[i].g << 8, threshold, level_sum[1]);
+            buffer[i].b = output(GAMMA_B, buffer[i].b << 8, threshold, level_sum[2]);
+        }
+        return;
+    }
+    // keep + amount = 256, so the blend already is the 8.8 value
+    uint16_t keep = 256 - amount;
+    for (uint16_t i = from; i < to; i++) {
+        uint8_t threshold = output_threshold(frame_index, i);
+        buffer[i].r = output(GAMMA_R, fade[i].r * keep + buffer[i].r * amount, threshold, level_sum[0]);
+        buffer[i].g = output(GAMMA_G, fade[i].g * keep + buffer[i].g * amount, threshold, level_sum[1]);
+        buffer[i].b = output(GAMMA_B, fade[i].b * keep + buffer[i].b * amount, threshold, level_sum[2]);
+    }
+}
+
+// caller holds led_output_mutex and led_data_mutex, so neither stage is using the old buffers
+bool LedStrip::allocate_buffers(uint16_t length) {
+    if (length == buffer_capacity && led_buffers[0]) return true;
+    buffer_generation++;
+    // release the old pair first so shrinking/growing does not need both sizes at once
+    led_buffers[0].reset();
+    led_buffers[1].reset();
+    fade_buffer.reset();
+    buffer_capacity = 0;
+    size_t pixels = std::max<uint16_t>(length, 1);
+    led_buffers[0].reset(new (std::nothrow) CRGB[pixels]);
+    led_buffers[1].reset(new (std::nothrow) CRGB[pixels]);
+    fade_buffer.reset(new (std::nothrow) CRGB[pixels]);
+    if (!led_buffers[0] || !led_buffers[1] || !fade_buffer) {
+        led_buffers[0].reset();
+        led_buffers[1].reset();
+        fade_buffer.reset();
+        return false;
+    }
+    buffer_capacity = length;
+    front_buffer.store(0, std::memory_order_release);
+    return true;
+}
+
+CRGB* LedStrip::back_buffer() {
+    return led_buffers[1 - front_buffer.load(std::memory_order_acquire)].get();
+}
+
+bool LedStrip::publish_frame(uint32_t generation) {
+    if (output_task) {
+        // the back buffer was rendered while the previous frame was on the wire, it only has to be
+        // off the wire before the swap hands its buffer back to the renderer. no mutex is held here,
+        // setters and getters keep running while the wire is busy
+        if (xSemaphoreTake(output_done, pdMS_TO_TICKS(OUTPUT_WAIT_MS)) != pdTRUE) {
+            // the output task may still be clocking out the front buffer, swapping would tear it
+            DBG_PRINTLN(LedStrip, "ERROR: Could not take output_done in publish_frame, frame dropped");
+            return false;
+        }
+        stage_done(FrameStage::WAIT);
+#if LED_STRIP_FRAME_STATS
+        uint32_t show_us = output_show_us.exchange(0);
+        if (show_us) frame_stats.record(FrameStage::SHOW, show_us);
+#endif
+    }
+    bool published = false;
+    if (xSemaphoreTake(led_data_mutex, portMAX_DELAY) == pdTRUE) {
+        // set_length reallocated the buffers since the frame was rendered, its back buffer is gone
+        if (generation == buffer_generation) {
+            front_buffer.store(1 - front_buffer.load(std::memory_order_relaxed), std::memory_order_release);
+            published_generation = generation;
+            published = true;
+        }
+        xSemaphoreGive(led_data_mutex);
+    } else {
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_data_mutex in publish_frame");
+    }
+    if (output_task) {
+        if (published) {
+            output_claimed = true;
         } else {
-            leds[i] = CRGB(color_rgb[0], color_rgb[1], color_rgb[2]);
+            xSemaphoreGive(output_done);
+        }
+    }
+    return published;
+}
+
+// output stage: clocks out the last published frame, never the buffer being rendered
+void LedStrip::show_frame(uint16_t output_length) {
+    if (output_task) {
+        if (!output_claimed) return;
+        output_claimed = false;
+        output_length_pending = output_length;
+        xTaskNotifyGive(output_task);
+        return;
+    }
+    if (xSemaphoreTake(led_output_mutex, portMAX_DELAY) == pdTRUE) {
+        // set_length may have reallocated since the frame was published
+        output_length = published_generation == buffer_generation ? std::min(output_length, buffer_capacity) : 0;
+        if (output_length > 0) {
+            bind_channels(led_buffers[front_buffer.load(std::memory_order_acquire)].get(), output_length);
+            FastLED.show();
+            stage_done(FrameStage::SHOW);
         }
+        xSemaphoreGive(led_output_mutex);
+    } else {
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_output_mutex in show_frame");
     }
-//    DBG_PRINTLN(LedStrip, "<- LedStrip::set_pixel()");
 }
 
 void LedStrip::set_length(uint16_t new_length) {
@@ -606,21 +1302,39 @@ void LedStrip::set_length(uint16_t new_length) {
         controller.serial_port.println("That's too many. Max supported: " + std::to_string(LED_STRIP_NUM_LEDS_MAX) + " LEDs");
         return;
     }
+    // the only place holding both mutexes: publish_frame() waits for the output task holding neither,
+    // and the output task only takes led_output_mutex, so this nesting can not close a cycle
     if (xSemaphoreTake(led_data_mutex, portMAX_DELAY) == pdTRUE) {
-        if (leds) {
-            for (uint16_t i = 0; i < num_led; i++) {
-                leds[i] = CRGB::Black;
-            }
-            if (num_led > 0) {
+        if (xSemaphoreTake(led_output_mutex, portMAX_DELAY) == pdTRUE) {
+            // a frame already handed to the output task is dropped. its notification stays pending so the
+            // task still wakes and gives output_done back
+            output_length_pending = 0;
+            // blank the current length before the buffers shrink and the tail can no longer be addressed
+            CRGB* front = led_buffers[front_buffer.load(std::memory_order_acquire)].get();
+            if (front && num_led > 0) {
+                fill_solid(front, num_led, CRGB::Black);
+                bind_channels(front, num_led);
                 FastLED.show();
             }
+            if (allocate_buffers(new_length)) {
+                num_led = new_length;
+            } else {
+                controller.serial_port.printf("Not enough memory for %u LEDs\n", new_length);
+                num_led = allocate_buffers(num_led) ? num_led : 0;
+            }
+            bind_channels(led_buffers[0].get(), num_led);
+            frame_dirty.store(true);
+            DBG_PRINTF(LedStrip, "Set num_led to %u\n", num_led);
+            update_frame_delay();
+            xSemaphoreGive(led_output_mutex);
+        } else {
+            DBG_PRINTLN(LedStrip, "ERROR: Could not take led_output_mutex in set_length");
         }
-        num_led = new_length;
-        DBG_PRINTF(LedStrip, "Set num_led to %u\n", num_led);
         xSemaphoreGive(led_data_mutex);
     } else {
         DBG_PRINTLN(LedStrip, "ERROR: Could not take led_data_mutex in set_length");
     }
+    wake_render();
     DBG_PRINTLN(LedStrip, "<- LedStrip::set_length()");
 }
 
@@ -630,6 +1344,317 @@ uint16_t LedStrip::get_length() const {
     return num_led;
 }
 
+bool LedStrip::add_segment(uint16_t start, uint16_t length, bool reverse) {
+    DBG_PRINTF(LedStrip, "-> LedStrip::add_segment(start: %u, length: %u, reverse: %u)\n", start, length, reverse);
+    bool added = false;
+    if (length == 0 || start + length > LED_STRIP_NUM_LEDS_MAX) {
+        controller.serial_port.println("Segment must fit within " + std::to_string(LED_STRIP_NUM_LEDS_MAX) + " LEDs");
+        return false;
+    }
+    if (xSemaphoreTake(led_mode_mutex, portMAX_DELAY) == pdTRUE) {
+        if (segments.size() >= LED_STRIP_SEGMENTS_MAX) {
+            controller.serial_port.println("That's too many. Max supported: " + std::to_string(LED_STRIP_SEGMENTS_MAX) + " segments");
+        } else if (!segment_range_free(start, length, -1)) {
+            controller.serial_port.println("Segment overlaps an existing segment");
+        } else {
+            // a new zone starts with the strip color so adding it does not visibly change anything
+            std::array<uint8_t, 3> rgb = led_mode ? led_mode->get_rgb() : std::array<uint8_t, 3>{0, 0, 0};
+            segments.push_back(std::make_unique<Segment>(this, start, length, reverse, rgb, 255,
+                                                         color_transition_delay, brightness_transition_delay,
+                                                         color_easing, brightness_easing));
+            sort_segments();
+            added = true;
+        }
+        xSemaphoreGive(led_mode_mutex);
+    } else {
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in add_segment");
+    }
+    if (added) save_segments();
+    wake_render();
+    DBG_PRINTLN(LedStrip, "<- LedStrip::add_segment()");
+    return added;
+}
+
+bool LedStrip::resize_segment(uint8_t id, uint16_t start, uint16_t length) {
+    DBG_PRINTF(LedStrip, "-> LedStrip::resize_segment(id: %u, start: %u, length: %u)\n", id, start, length);
+    bool resized = false;
+    if (length == 0 || start + length > LED_STRIP_NUM_LEDS_MAX) {
+        controller.serial_port.println("Segment must fit within " + std::to_string(LED_STRIP_NUM_LEDS_MAX) + " LEDs");
+        return false;
+    }
+    if (xSemaphoreTake(led_mode_mutex, portMAX_DELAY) == pdTRUE) {
+        if (id >= segments.size()) {
+            controller.serial_port.println("No such segment");
+        } else if (!segment_range_free(start, length, id)) {
+            controller.serial_port.println("Segment overlaps an existing segment");
+        } else {
+            segments[id]->set_range(start, length);
+            sort_segments();
+            resized = true;
+        }
+        xSemaphoreGive(led_mode_mutex);
+    } else {
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in resize_segment");
+    }
+    if (resized) save_segments();
+    wake_render();
+    DBG_PRINTLN(LedStrip, "<- LedStrip::resize_segment()");
+    return resized;
+}
+
+bool LedStrip::remove_segment(uint8_t id) {
+    DBG_PRINTF(LedStrip, "-> LedStrip::remove_segment(id: %u)\n", id);
+    bool removed = false;
+    if (xSemaphoreTake(led_mode_mutex, portMAX_DELAY) == pdTRUE) {
+        if (id < segments.size()) {
+            segments.erase(segments.begin() + id);
+            removed = true;
+        } else {
+            controller.serial_port.println("No such segment");
+        }
+        xSemaphoreGive(led_mode_mutex);
+    } else {
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in remove_segment");
+    }
+    if (removed) save_segments();
+    wake_render();
+    DBG_PRINTLN(LedStrip, "<- LedStrip::remove_segment()");
+    return removed;
+}
+
+bool LedStrip::set_segment_rgb(uint8_t id, std::array<uint8_t, 3> new_rgb) {
+    DBG_PRINTF(LedStrip, "-> LedStrip::set_segment_rgb(id: %u, rgb: {%u, %u, %u})\n", id, new_rgb[0], new_rgb[1], new_rgb[2]);
+    bool updated = false;
+    if (xSemaphoreTake(led_mode_mutex, portMAX_DELAY) == pdTRUE) {
+        if (id < segments.size()) {
+            segments[id]->set_rgb(new_rgb);
+            updated = true;
+        } else {
+            controller.serial_port.println("No such segment");
+        }
+        xSemaphoreGive(led_mode_mutex);
+    } else {
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in set_segment_rgb");
+    }
+    if (updated) save_segments();
+    wake_render();
+    DBG_PRINTLN(LedStrip, "<- LedStrip::set_segment_rgb()");
+    return updated;
+}
+
+bool LedStrip::set_segment_mode(uint8_t id, uint8_t mode_id) {
+    DBG_PRINTF(LedStrip, "-> LedStrip::set_segment_mode(id: %u, mode_id: %u)\n", id, mode_id);
+    bool updated = false;
+    if (xSemaphoreTake(led_mode_mutex, portMAX_DELAY) == pdTRUE) {
+        if (id >= segments.size()) {
+            controller.serial_port.println("No such segment");
+        } else if (segments[id]->set_mode(mode_id)) {
+            updated = true;
+        } else {
+            controller.serial_port.println("No such mode");
+        }
+        xSemaphoreGive(led_mode_mutex);
+    } else {
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in set_segment_mode");
+    }
+    if (updated) save_segments();
+    wake_render();
+    DBG_PRINTLN(LedStrip, "<- LedStrip::set_segment_mode()");
+    return updated;
+}
+
+bool LedStrip::set_segment_brightness(uint8_t id, uint8_t new_brightness) {
+    DBG_PRINTF(LedStrip, "-> LedStrip::set_segment_brightness(id: %u, brightness: %u)\n", id, new_brightness);
+    bool updated = false;
+    if (xSemaphoreTake(led_mode_mutex, portMAX_DELAY) == pdTRUE) {
+        if (id < segments.size()) {
+            segments[id]->set_brightness(new_brightness);
+            updated = true;
+        } else {
+            controller.serial_port.println("No such segment");
+        }
+        xSemaphoreGive(led_mode_mutex);
+    } else {
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in set_segment_brightness");
+    }
+    if (updated) save_segments();
+    wake_render();
+    DBG_PRINTLN(LedStrip, "<- LedStrip::set_segment_brightness()");
+    return updated;
+}
+
+uint8_t LedStrip::get_segment_count() const {
+    return static_cast<uint8_t>(segments.size());
+}
+
+bool LedStrip::set_palette(uint8_t slot, const std::string& config) {
+    DBG_PRINTF(LedStrip, "-> LedStrip::set_palette(slot: %u, config: %s)\n", slot, config.c_str());
+    std::array<PaletteStop, Palette::STOPS_MAX> stops;
+    uint8_t count = 0;
+    if (slot >= LED_STRIP_PALETTES_MAX || !Palette::parse_config(config, stops, count)) {
+        controller.serial_port.println("Invalid palette");
+        return false;
+    }
+    controller.nvs.write_str(nvs_key, "pal_cfg_" + std::to_string(slot), config);
+    if (slot == palette_slot) apply_palette(config);
+    DBG_PRINTLN(LedStrip, "<- LedStrip::set_palette()");
+    return true;
+}
+
+void LedStrip::set_power_budget(uint16_t budget_ma) {
+    DBG_PRINTF(LedStrip, "-> LedStrip::set_power_budget(budget_ma: %u)\n", budget_ma);
+    power_limiter.set_budget_ma(budget_ma);
+    current_limiter.set_budget_ma(budget_ma);
+    if (xSemaphoreTake(led_mode_mutex, portMAX_DELAY) == pdTRUE) {
+        frame_dirty.store(true);
+        xSemaphoreGive(led_mode_mutex);
+    } else {
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in set_power_budget");
+    }
+    controller.nvs.write_uint16(nvs_key, "pwr_budget", budget_ma);
+    wake_render();
+    DBG_PRINTLN(LedStrip, "<- LedStrip::set_power_budget()");
+}
+
+uint16_t LedStrip::get_power_budget() const {
+    return power_limiter.get_budget_ma();
+}
+
+uint32_t LedStrip::get_current_ma(bool& measured) const {
+    measured = current_source != nullptr;
+    return measured ? current_limiter.get_sample_ma() : power_limiter.get_limited_ma();
+}
+
+bool LedStrip::is_idle() const {
+    return render_idle;
+}
+
+uint32_t LedStrip::get_render_busy_us() const {
+    return render_busy_us;
+}
+
+bool LedStrip::select_palette(uint8_t slot) {
+    DBG_PRINTF(LedStrip, "-> LedStrip::select_palette(slot: %u)\n", slot);
+    if (slot >= LED_STRIP_PALETTES_MAX || !apply_palette(controller.nvs.read_str(nvs_key, "pal_cfg_" + std::to_string(slot)))) {
+        controller.serial_port.println("No such palette");
+        return false;
+    }
+    palette_slot = slot;
+    controller.nvs.write_uint8(nvs_key, "pal_sel", slot);
+    DBG_PRINTLN(LedStrip, "<- LedStrip::select_palette()");
+    return true;
+}
+
+// removing the selected palette falls back to the built-in rainbow
+bool LedStrip::remove_palette(uint8_t slot) {
+    DBG_PRINTF(LedStrip, "-> LedStrip::remove_palette(slot: %u)\n", slot);
+    if (slot >= LED_STRIP_PALETTES_MAX) return false;
+    controller.nvs.remove(nvs_key, "pal_cfg_" + std::to_string(slot));
+    if (slot == palette_slot) {
+        if (xSemaphoreTake(led_mode_mutex, portMAX_DELAY) == pdTRUE) {
+            palette = Palette();
+            xSemaphoreGive(led_mode_mutex);
+        } else {
+            DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in remove_palette");
+        }
+    }
+    wake_render();
+    DBG_PRINTLN(LedStrip, "<- LedStrip::remove_palette()");
+    return true;
+}
+
+uint8_t LedStrip::get_palette_slot() const {
+    return palette_slot;
+}
+
+const Palette& LedStrip::get_palette() const {
+    return palette;
+}
+
+// parses outside the mutex, only the table expansion runs under it
+bool LedStrip::apply_palette(const std::string& config) {
+    std::array<PaletteStop, Palette::STOPS_MAX> stops;
+    uint8_t count = 0;
+    if (!Palette::parse_config(config, stops, count)) return false;
+    bool applied = false;
+    if (xSemaphoreTake(led_mode_mutex, portMAX_DELAY) == pdTRUE) {
+        applied = palette.set_stops(stops.data(), count);
+        frame_dirty.store(true);
+        xSemaphoreGive(led_mode_mutex);
+    } else {
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in apply_palette");
+    }
+    wake_render();
+    return applied;
+}
+
+// caller holds led_mode_mutex
+bool LedStrip::segment_range_free(uint16_t start, uint16_t length, int skip_id) const {
+    for (size_t i = 0; i < segments.size(); i++) {
+        if (static_cast<int>(i) == skip_id) continue;
+        if (start < segments[i]->get_end() && segments[i]->get_start() < start + length) return false;
+    }
+    return true;
+}
+
+// caller holds led_mode_mutex; compose_frame relies on the table being ordered by start
+void LedStrip::sort_segments() {
+    std::sort(segments.begin(), segments.end(),
+              [](const std::unique_ptr<Segment>& a, const std::unique_ptr<Segment>& b) {
+                  return a->get_start() < b->get_start();
+              });
+}
+
+void LedStrip::load_segments() {
+    DBG_PRINTLN(LedStrip, "-> LedStrip::load_segments()");
+    int seg_count = std::min<int>(controller.nvs.read_uint8(nvs_key, "seg_count", 0), LED_STRIP_SEGMENTS_MAX);
+    if (xSemaphoreTake(led_mode_mutex, portMAX_DELAY) == pdTRUE) {
+        segments.clear();
+        for (int i = 0; i < seg_count; i++) {
+            uint16_t start = 0, length = 0;
+            bool reverse = false;
+            std::array<uint8_t, 3> rgb = {0, 0, 0};
+            uint8_t segment_brightness = 255;
+            uint8_t mode_id = ColorSolid::INFO.id;
+            std::string cfg = controller.nvs.read_str(nvs_key, "seg_cfg_" + std::to_string(i));
+            if (!Segment::parse_config(cfg, start, length, reverse, rgb, segment_brightness, mode_id)) continue;
+            if (!segment_range_free(start, length, -1)) continue;
+            segments.push_back(std::make_unique<Segment>(this, start, length, reverse, rgb, segment_brightness,
+                                                         color_transition_delay, brightness_transition_delay,
+                                                         color_easing, brightness_easing));
+            if (mode_id != ColorSolid::INFO.id) segments.back()->set_mode(mode_id);
+        }
+        sort_segments();
+        xSemaphoreGive(led_mode_mutex);
+    } else {
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in load_segments");
+    }
+    DBG_PRINTLN(LedStrip, "<- LedStrip::load_segments()");
+}
+
+// the table is tiny, so it is rewritten as a whole; NVS writes happen outside the mode mutex
+void LedStrip::save_segments() {
+    DBG_PRINTLN(LedStrip, "-> LedStrip::save_segments()");
+    std::vector<std::string> cfgs;
+    if (xSemaphoreTake(led_mode_mutex, portMAX_DELAY) == pdTRUE) {
+        cfgs.reserve(segments.size());
+        for (const auto& segment : segments) cfgs.push_back(segment->to_config());
+        xSemaphoreGive(led_mode_mutex);
+    } else {
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in save_segments");
+        return;
+    }
+    int old_count = controller.nvs.read_uint8(nvs_key, "seg_count", 0);
+    for (size_t i = 0; i < cfgs.size(); i++) {
+        controller.nvs.write_str(nvs_key, "seg_cfg_" + std::to_string(i), cfgs[i]);
+    }
+    for (int i = cfgs.size(); i < old_count; i++) {
+        controller.nvs.remove(nvs_key, "seg_cfg_" + std::to_string(i));
+    }
+    controller.nvs.write_uint8(nvs_key, "seg_count", cfgs.size());
+    DBG_PRINTLN(LedStrip, "<- LedStrip::save_segments()");
+}
+
 std::array<uint8_t,3> LedStrip::get_rgb() const {
     DBG_PRINTLN(LedStrip, "-> LedStrip::get_rgb()");
     std::array<uint8_t,3> res = {0,0,0};
@@ -826,14 +1851,14 @@ bool LedStrip::get_state() const {
     return res;
 }
 
-String LedStrip::get_mode_name() const {
+const char* LedStrip::get_mode_name() const {
     DBG_PRINTLN(LedStrip, "-> LedStrip::get_mode_name()");
-    String res = "";
+    const char* res = "";
     if (xSemaphoreTake(const_cast<LedStrip*>(this)->led_mode_mutex, portMAX_DELAY) == pdTRUE) {
         if (led_mode) res = led_mode->get_mode_name();
         xSemaphoreGive(const_cast<LedStrip*>(this)->led_mode_mutex);
     } else { DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in get_mode_name"); }
-    DBG_PRINTF(LedStrip, "<- LedStrip::get_mode_name() returns: %s\n", res.c_str());
+    DBG_PRINTF(LedStrip, "<- LedStrip::get_mode_name() returns: %s\n", res);
     return res;
 }
 
@@ -848,14 +1873,14 @@ uint8_t LedStrip::get_mode_id() const {
     return res;
 }
 
-String LedStrip::get_target_mode_name() const {
+const char* LedStrip::get_target_mode_name() const {
     DBG_PRINTLN(LedStrip, "-> LedStrip::get_target_mode_name()");
-    String res = "";
+    const char* res = "";
     if (xSemaphoreTake(const_cast<LedStrip*>(this)->led_mode_mutex, portMAX_DELAY) == pdTRUE) {
         if (led_mode) res = led_mode->get_target_mode_name();
         xSemaphoreGive(const_cast<LedStrip*>(this)->led_mode_mutex);
     } else { DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in get_target_mode_name"); }
-    DBG_PRINTF(LedStrip, "<- LedStrip::get_target_mode_name() returns: %s\n", res.c_str());
+    DBG_PRINTF(LedStrip, "<- LedStrip::get_target_mode_name() returns: %s\n", res);
     return res;
 }
 
@@ -1015,6 +2040,230 @@ void LedStrip::set_length_cli(std::string_view args_sv) {
     String args(args_sv.data(), args_sv.length());
     controller.sync_length(args.toInt(), {true, true, true, true, true});
 }
-std::string LedStrip::get_all_modes_list() const {
-    return R"({"0":"Solid Color","1":"Color Changing"})";
+
+void LedStrip::seg_add_cli(std::string_view args_sv) {
+    std::istringstream in{std::string(args_sv)};
+    unsigned start = 0, length = 0, reverse = 0;
+    if (!(in >> start >> length >> reverse)) return;
+    if (add_segment(start, length, reverse != 0)) seg_list_cli();
+}
+
+void LedStrip::seg_resize_cli(std::string_view args_sv) {
+    std::istringstream in{std::string(args_sv)};
+    unsigned id = 0, start = 0, length = 0;
+    if (!(in >> id >> start >> length)) return;
+    if (resize_segment(id, start, length)) seg_list_cli();
+}
+
+void LedStrip::seg_remove_cli(std::string_view args_sv) {
+    std::istringstream in{std::string(args_sv)};
+    unsigned id = 0;
+    if (!(in >> id)) return;
+    if (remove_segment(id)) seg_list_cli();
+}
+
+void LedStrip::seg_rgb_cli(std::string_view args_sv) {
+    std::istringstream in{std::string(args_sv)};
+    unsigned id = 0, r = 0, g = 0, b = 0;
+    if (!(in >> id >> r >> g >> b)) return;
+    set_segment_rgb(id, {static_cast<uint8_t>(r), static_cast<uint8_t>(g), static_cast<uint8_t>(b)});
+}
+
+void LedStrip::seg_brightness_cli(std::string_view args_sv) {
+    std::istringstream in{std::string(args_sv)};
+    unsigned id = 0, segment_brightness = 0;
+    if (!(in >> id >> segment_brightness)) return;
+    set_segment_brightness(id, static_cast<uint8_t>(segment_brightness));
+}
+
+void LedStrip::seg_mode_cli(std::string_view args_sv) {
+    std::istringstream in{std::string(args_sv)};
+    unsigned id = 0, mode_id = 0;
+    if (!(in >> id >> mode_id) || mode_id > 255) return;
+    set_segment_mode(id, static_cast<uint8_t>(mode_id));
+}
+
+void LedStrip::seg_list_cli() {
+    std::stringstream list_stream;
+    if (xSemaphoreTake(led_mode_mutex, portMAX_DELAY) == pdTRUE) {
+        if (segments.empty()) list_stream << "No segments, the strip mode covers all LEDs\n";
+        for (size_t i = 0; i < segments.size(); i++) {
+            std::array<uint8_t, 3> rgb = segments[i]->get_target_rgb();
+            list_stream << "    [" << i << "] LEDs " << segments[i]->get_start() << "-" << segments[i]->get_end() - 1
+                        << (segments[i]->is_reversed() ? " (reversed)" : "")
+                        << ", " << segments[i]->get_mode_name()
+                        << ", RGB (" << static_cast<int>(rgb[0]) << ", " << static_cast<int>(rgb[1]) << ", " << static_cast<int>(rgb[2]) << ")"
+                        << ", brightness " << static_cast<int>(segments[i]->get_brightness()) << "\n";
+        }
+        xSemaphoreGive(led_mode_mutex);
+    } else {
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in seg_list_cli");
+    }
+    controller.serial_port.print(list_stream.str().c_str());
+}
+
+void LedStrip::pal_set_cli(std::string_view args_sv) {
+    std::istringstream in{std::string(args_sv)};
+    unsigned slot = 0;
+    std::string config;
+    if (!(in >> slot >> config)) return;
+    if (set_palette(slot, config)) pal_list_cli();
+}
+
+void LedStrip::pal_select_cli(std::string_view args_sv) {
+    std::istringstream in{std::string(args_sv)};
+    unsigned slot = 0;
+    if (!(in >> slot)) return;
+    if (select_palette(slot)) pal_list_cli();
+}
+
+void LedStrip::pal_remove_cli(std::string_view args_sv) {
+    std::istringstream in{std::string(args_sv)};
+    unsigned slot = 0;
+    if (!(in >> slot)) return;
+    if (remove_palette(slot)) pal_list_cli();
+}
+
+void LedStrip::pal_list_cli() {
+    std::stringstream list_stream;
+    for (uint8_t i = 0; i < LED_STRIP_PALETTES_MAX; i++) {
+        std::string config = controller.nvs.read_str(nvs_key, "pal_cfg_" + std::to_string(i));
+        if (config.empty()) continue;
+        list_stream << "    [" << static_cast<int>(i) << "] " << config << (i == palette_slot ? " (selected)" : "") << "\n";
+    }
+    if (list_stream.str().empty()) list_stream << "No palettes, palette modes use the built-in rainbow\n";
+    controller.serial_port.print(list_stream.str().c_str());
+}
+
+void LedStrip::power_budget_cli(std::string_view args_sv) {
+    std::istringstream in{std::string(args_sv)};
+    unsigned budget_ma = 0;
+    if (!(in >> budget_ma)) return;
+    if (budget_ma > UINT16_MAX) {
+        controller.serial_port.printf("Budget is out of range, max %u mA\n", UINT16_MAX);
+        return;
+    }
+    set_power_budget(budget_ma);
+    controller.serial_port.printf("Power budget: %u mA%s\n", budget_ma, budget_ma ? "" : " (unlimited)");
+}
+
+// renders every selectable mode into a scratch buffer for BENCHMARK_FRAMES frames of the configured
+// frame period, then runs the output pass of a crossfade over it. holds led_mode_mutex so the render
+// task does not preempt the measurement, the strip output pauses for the duration
+void LedStrip::benchmark_cli() {
+    DBG_PRINTLN(LedStrip, "-> LedStrip::benchmark_cli()");
+    constexpr uint16_t BENCHMARK_FRAMES = 100;
+    std::unique_ptr<CRGB[]> scratch(new (std::nothrow) CRGB[num_led]);
+    std::unique_ptr<CRGB[]> fade_scratch(new (std::nothrow) CRGB[num_led]);
+    // its own stats, so the benchmark switches do not show up in the mode change count of the strip
+    LedModeSlotStats bench_stats;
+    std::unique_ptr<StripModeSlot> bench_slot(new (std::nothrow) StripModeSlot(bench_stats));
+    if (!scratch || !fade_scratch || !bench_slot) {
+        controller.serial_port.println("Benchmark: not enough memory for a scratch buffer");
+        return;
+    }
+    std::ostringstream result_stream;
+    result_stream << "Render cost at " << num_led << " LEDs, " << BENCHMARK_FRAMES << " frames per mode, "
+                  << static_cast<int>(led_controller_frame_delay) << " ms frame interval\n";
+    // budgets are shares of the frame interval, which already follows the strip length
+    auto report = [&](const char* name, uint32_t frame_us, uint16_t budget_permille) {
+        uint32_t budget_us = static_cast<uint32_t>(led_controller_frame_delay) * budget_permille;
+        uint32_t used_permille = led_controller_frame_delay ? frame_us / led_controller_frame_delay : 0;
+        result_stream << "    " << name << ": " << frame_us << " us/frame, " << used_permille / 10 << "."
+                      << used_permille % 10 << "% of the frame, budget " << budget_us << " us ("
+                      << budget_permille / 10 << "." << budget_permille % 10 << "%)"
+                      << (frame_us > budget_us ? " (OVER BUDGET)" : "") << "\n";
+    };
+
+    if (xSemaphoreTake(led_mode_mutex, portMAX_DELAY) == pdTRUE) {
+        std::array<uint8_t, 3> rgb = led_mode ? led_mode->get_rgb() : std::array<uint8_t, 3>{255, 0, 0};
+        for (const LedModeInfo& info : LED_MODES) {
+            LedMode* mode = bench_slot->emplace(info, this, rgb);
+            if (!mode) continue;
+            FrameContext ctx;
+            ctx.delta_us = static_cast<uint32_t>(led_controller_frame_delay) * 1000;
+
+            uint32_t start_us = micros();
+            for (uint16_t i = 0; i < BENCHMARK_FRAMES; i++) {
+                ctx.now_us += ctx.delta_us;
+                ctx.frame_index = i;
+                mode->loop();
+                mode->render(std::span<CRGB>(scratch.get(), num_led), ctx);
+            }
+            report(info.name, (micros() - start_us) / BENCHMARK_FRAMES, info.frame_budget_permille);
+        }
+
+        // blend, brightness, gamma, power limit and quantize of a half way crossfade, the most expensive output frame
+        std::copy(scratch.get(), scratch.get() + num_led, fade_scratch.get());
+        BrightnessFrame frame_brightness = brightness ? brightness->get_frame() : BrightnessFrame{};
+        std::array<uint32_t, 3> level_sum = {0, 0, 0};
+        uint32_t start_us = micros();
+        for (uint16_t i = 0; i < BENCHMARK_FRAMES; i++) {
+            output_range(scratch.get(), fade_scratch.get(), 128, frame_brightness, PowerLimiter::SCALE_ONE / 2, i,
+                         0, num_led, level_sum);
+        }
+        report("Output pass", (micros() - start_us) / BENCHMARK_FRAMES, OUTPUT_PASS_BUDGET_PERMILLE);
+        xSemaphoreGive(led_mode_mutex);
+    } else {
+        DBG_PRINTLN(LedStrip, "ERROR: Could not take led_mode_mutex in benchmark_cli");
+    }
+    controller.serial_port.print(result_stream.str().c_str());
+    DBG_PRINTLN(LedStrip, "<- LedStrip::benchmark_cli()");
+}
+
+void LedStrip::stats_cli() {
+#if LED_STRIP_FRAME_STATS
+    FrameStats::Stage frame = frame_stats.snapshot(FrameStage::FRAME);
+    std::ostringstream result_stream;
+    result_stream << "Frame stats over " << frame.count << " frames, " << static_cast<int>(led_controller_frame_delay)
+                  << " ms period: " << frames_pushed << " pushed, " << frames_skipped << " skipped, "
+                  << frame_stats.get_dropped() << " dropped\n"
+                  << "    stage        count      min      avg      p99      max  (us)\n";
+    for (uint8_t i = 0; i < FrameStats::STAGES; i++) {
+        FrameStage stage = static_cast<FrameStage>(i);
+        FrameStats::Stage s = frame_stats.snapshot(stage);
+        result_stream << "    " << std::left << std::setw(8) << FrameStats::stage_name(stage) << std::right
+                      << std::setw(10) << s.count
+                      << std::setw(9) << (s.count ? s.min_us : 0)
+                      << std::setw(9) << s.avg_us()
+                      << std::setw(9) << s.percentile_us(990)
+                      << std::setw(9) << s.max_us << "\n";
+    }
+    controller.serial_port.print(result_stream.str().c_str());
+#else
+    controller.serial_port.println("Frame stats are compiled out, set LED_STRIP_FRAME_STATS to 1");
+#endif
+}
+
+void LedStrip::stats_reset_cli() {
+#if LED_STRIP_FRAME_STATS
+    frame_stats.reset();
+    controller.serial_port.println("Frame stats cleared");
+#else
+    controller.serial_port.println("Frame stats are compiled out, set LED_STRIP_FRAME_STATS to 1");
+#endif
+}
+
+std::string LedStrip::get_frame_stats_json() const {
+#if LED_STRIP_FRAME_STATS
+    std::ostringstream json;
+    json << "{\"enabled\":true,\"period_us\":" << static_cast<uint32_t>(led_controller_frame_delay) * 1000
+         << ",\"pushed\":" << frames_pushed << ",\"skipped\":" << frames_skipped
+         << ",\"dropped\":" << frame_stats.get_dropped() << ",\"stages\":{";
+    for (uint8_t i = 0; i < FrameStats::STAGES; i++) {
+        FrameStage stage = static_cast<FrameStage>(i);
+        FrameStats::Stage s = frame_stats.snapshot(stage);
+        json << (i ? "," : "") << "\"" << FrameStats::stage_name(stage) << "\":{\"count\":" << s.count
+             << ",\"min\":" << (s.count ? s.min_us : 0) << ",\"avg\":" << s.avg_us()
+             << ",\"p99\":" << s.percentile_us(990) << ",\"max\":" << s.max_us << "}";
+    }
+    json << "}}";
+    return json.str();
+#else
+    return "{\"enabled\":false}";
+#endif
+}
+
+const char* LedStrip::get_all_modes_list() const {
+    return LED_MODES_JSON.data();
 }
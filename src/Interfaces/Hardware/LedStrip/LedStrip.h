@@ -21,28 +21,57 @@
 #include <FastLED.h>
 #include <memory>
 #include <array>
+#include <atomic>
 #include <string>
 #include <sstream>
+#include <iomanip>
+#include <vector>
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
+#include "freertos/task.h"
 
 #include "AsyncTimer/AsyncTimer.h"
 #include "Brightness/Brightness.h"
 #include "LedModes/LedMode.h"
-#include "LedModes/ColorSolid/ColorSolid.h"
-#include "LedModes/ColorChanging/ColorChanging.h"
+#include "LedModes/LedModeRegistry.h"
+#include "Segment/Segment.h"
+#include "Palette/Palette.h"
+#include "Gamma/Gamma.h"
+#include "Dither/Dither.h"
+#include "PowerLimiter/PowerLimiter.h"
+#include "FrameStats/FrameStats.h"
+#include "CurrentSense/CurrentLimiter.h"
+#include "CurrentSense/AdcCurrentSource.h"
 
 
-enum LedModeID : uint8_t {
-    COLOR_SOLID = 0,
-    COLOR_CHANGING = 1,
-};
+#if   defined(PIN_LED_STRIP_4)
+  #define LED_STRIP_CHANNELS        4
+#elif defined(PIN_LED_STRIP_3)
+  #define LED_STRIP_CHANNELS        3
+#elif defined(PIN_LED_STRIP_2)
+  #define LED_STRIP_CHANNELS        2
+#else
+  #define LED_STRIP_CHANNELS        1
+#endif
+
 
 struct LedStripConfig : public ModuleConfig {
     uint16_t                    num_led                     = LED_STRIP_NUM_LEDS_MAX;
     uint16_t                    color_transition_delay      = 900;
-    uint8_t                     led_controller_frame_delay  = 20;
+    // ms between frames, 0 derives it from the strip length (see auto_frame_delay)
+    uint8_t                     led_controller_frame_delay  = 0;
     uint16_t                    brightness_transition_delay = 500;
+    bool                        render_task_enabled         = true;
+    uint8_t                     render_task_priority        = 3;
+    uint32_t                    render_task_stack_size      = 4096;
+    // FastLED.show() runs in its own task so the next frame renders while this one is on the wire
+    bool                        output_task_enabled         = true;
+    uint8_t                     output_task_priority        = 4;
+    uint32_t                    output_task_stack_size      = 2048;
+    // builds the strip current source; nullptr uses the ADC on PIN_STRIP_ISENSE when it is defined
+    std::unique_ptr<CurrentSource> (*make_current_source)   () = nullptr;
+    Easing                      color_easing                = Easing::LINEAR;
+    Easing                      brightness_easing           = Easing::PERCEPTUAL;
 };
 
 
@@ -88,11 +117,39 @@ public:
     void                        turn_on                     ();
     void                        turn_off                    ();
 
-    void                        fill_all                    (std::array<uint8_t, 3> color_rgb);
-    void                        set_pixel                   (uint16_t i, std::array<uint8_t, 3> color_rgb);
     void                        set_length                  (uint16_t length);
     uint16_t                    get_length                  () const;
 
+    // segments are non-overlapping zones drawn on top of the strip mode, ids are their order by start
+    bool                        add_segment                 (uint16_t start, uint16_t length, bool reverse);
+    bool                        resize_segment              (uint8_t id, uint16_t start, uint16_t length);
+    bool                        remove_segment              (uint8_t id);
+    bool                        set_segment_rgb             (uint8_t id, std::array<uint8_t, 3> new_rgb);
+    bool                        set_segment_brightness      (uint8_t id, uint8_t new_brightness);
+    bool                        set_segment_mode            (uint8_t id, uint8_t mode_id);
+    uint8_t                     get_segment_count           () const;
+
+    // palettes live in NVS slots 0..LED_STRIP_PALETTES_MAX-1, only the selected one is expanded in RAM
+    bool                        set_palette                 (uint8_t slot, const std::string& config);
+    bool                        select_palette              (uint8_t slot);
+    bool                        remove_palette              (uint8_t slot);
+    uint8_t                     get_palette_slot            () const;
+    // for modes during render(), the caller holds led_mode_mutex
+    const Palette&              get_palette                 () const;
+
+    // estimated strip current cap in mA, 0 = unlimited, stored in NVS
+    void                        set_power_budget            (uint16_t budget_ma);
+    uint16_t                    get_power_budget            () const;
+    // strip current in mA, measured when a sense pin is configured, the power estimate otherwise
+    uint32_t                    get_current_ma              (bool& measured) const;
+
+    // true while the render task is parked on a static frame
+    bool                        is_idle                     () const;
+    // total time the render task spent in render_frame() since boot, 0 when frames run in loop()
+    uint32_t                    get_render_busy_us          () const;
+    // per stage frame timing as JSON for the web /stats endpoint, {"enabled":false} without LED_STRIP_FRAME_STATS
+    std::string                 get_frame_stats_json        () const;
+
     std::array<uint8_t, 3>      get_rgb                     () const;
     uint8_t                     get_r                       () const;
     uint8_t                     get_g                       () const;
@@ -115,24 +172,102 @@ public:
 
     uint8_t                     get_brightness              () const;
     bool                        get_state                   () const;
-    String                      get_mode_name               () const;
+    const char*                 get_mode_name               () const;
     uint8_t                     get_mode_id                 () const;
 
     uint8_t                     get_target_brightness       () const;
     bool                        get_target_state            () const;
     uint8_t                     get_target_mode_id          () const;
-    String                      get_target_mode_name        () const;
-    std::string                 get_all_modes_list          () const;
+    const char*                 get_target_mode_name        () const;
+    // {"<id>":"<name>",...} of the modes set_mode accepts, generated from LED_MODES at compile time
+    const char*                 get_all_modes_list          () const;
 
 private:
-    CRGB                        leds                        [LED_STRIP_NUM_LEDS_MAX];
+    // front/back framebuffers: the renderer fills the back buffer and publishes it by
+    // swapping front_buffer, the output stage only ever reads the published front buffer
+    // both buffers are heap allocated for exactly num_led pixels and reallocated by set_length
+    std::unique_ptr<CRGB[]>     led_buffers                 [2];
+    // the one extra buffer a mode crossfade renders the outgoing mode into
+    std::unique_ptr<CRGB[]>     fade_buffer;
+    uint16_t                    buffer_capacity             = 0;
+    std::atomic<uint8_t>        front_buffer                {0};
+    // bumped by allocate_buffers(), a frame rendered into an older pair is never published or shown
+    std::atomic<uint32_t>       buffer_generation           {0};
+    std::atomic<uint32_t>       published_generation        {0};
     uint16_t                    num_led                     = LED_STRIP_NUM_LEDS_MAX;
     uint16_t                    color_transition_delay      = 900;
-    uint8_t                     led_controller_frame_delay  = 10;
+    uint8_t                     led_controller_frame_delay  = 20;
+    // follow the strip length with led_controller_frame_delay, set when the config leaves it at 0
+    bool                        frame_delay_auto            = true;
     uint16_t                    brightness_transition_delay = 500;
+    Easing                      color_easing                = Easing::LINEAR;
+    Easing                      brightness_easing           = Easing::PERCEPTUAL;
 
     SemaphoreHandle_t           led_mode_mutex;
     SemaphoreHandle_t           led_data_mutex;
+    SemaphoreHandle_t           led_output_mutex;
+
+    bool                        allocate_buffers            (uint16_t length);
+    CRGB*                       back_buffer                 ();
+    // waits until the front buffer is off the wire, then swaps, called without led_mode_mutex or
+    // led_data_mutex. false drops the frame (output task stuck, or set_length reallocated since the
+    // frame was rendered into generation), show_frame() is only called after a true
+    bool                        publish_frame               (uint32_t generation);
+    // hands the published frame to the output task, or clocks it out in place without one
+    void                        show_frame                  (uint16_t output_length);
+
+    // output channels: one FastLED controller per pin, each bound to a consecutive slice of
+    // the logical buffer so a frame takes as long as the longest slice, not the whole strip
+    void                        add_channels                ();
+    void                        bind_channels               (CRGB* buffer, uint16_t length);
+    static uint16_t             channel_offset              (uint8_t channel, uint16_t length);
+    static uint16_t             channel_length              (uint8_t channel, uint16_t length);
+    CLEDController*             channels                    [LED_STRIP_CHANNELS] = {};
+    void                        render_frame                ();
+    // base_level is the dimmed, gamma corrected base color in 8.8 fixed point (see output_level_q8)
+    bool                        compose_frame               (CRGB16 base_level,
+                                                             const std::vector<SegmentFrame>& segment_frames);
+    static CRGB16               output_level_q8             (CRGB16 color_q8,
+                                                             const BrightnessFrame& frame_brightness);
+    bool                        fill_level                  (CRGB* buffer, uint16_t from, uint16_t to,
+                                                             const CRGB16& level) const;
+    // renders into the back buffer under led_data_mutex, the caller publishes it once its mutexes are released
+    uint16_t                    compose_rendered_frame      (const BrightnessFrame& frame_brightness,
+                                                             uint16_t amount,
+                                                             const std::vector<SegmentFrame>& segment_frames,
+                                                             uint32_t& generation);
+    static void                 output_range                (CRGB* buffer, const CRGB* fade, uint16_t amount,
+                                                             const BrightnessFrame& frame_brightness,
+                                                             uint32_t power_scale_q16, uint32_t frame_index,
+                                                             uint16_t from, uint16_t to,
+                                                             std::array<uint32_t, 3>& level_sum);
+    FrameContext                frame_context;
+
+    // dedicated render task, paced with vTaskDelayUntil so network load does not shift frames
+    static void                 render_task_entry           (void* arg);
+    void                        render_task_loop            ();
+    TaskHandle_t                render_task                 = nullptr;
+    uint8_t                     render_task_priority        = 0;
+
+    // output task: owns FastLED.show() of the front buffer and gives output_done once the frame
+    // is clocked out, publish_frame() takes it before the next swap. output_claimed is set between
+    // that take and the hand-off in show_frame()
+    static void                 output_task_entry           (void* arg);
+    void                        output_task_loop            ();
+    TaskHandle_t                output_task                 = nullptr;
+    SemaphoreHandle_t           output_done                 = nullptr;
+    bool                        output_claimed              = false;
+    std::atomic<uint16_t>       output_length_pending       {0};
+    std::atomic<uint32_t>       output_show_us              {0};
+    // far above the wire time of LED_STRIP_NUM_LEDS_MAX, only reached when the output task is stuck
+    static constexpr uint32_t   OUTPUT_WAIT_MS              = 100;
+    // a frame with nothing left to animate parks the render task until a setter calls wake_render()
+    // (or LED_STRIP_IDLE_WAKE_MS passes), static frames are rounded instead of dithered so they settle
+    void                        wake_render                 ();
+    bool                        settle_output               = false;
+    std::atomic<bool>           render_idle                 {false};
+    std::atomic<bool>           render_wake_pending         {false};
+    std::atomic<uint32_t>       render_busy_us              {0};
 
     // CLI callbacks
     void                        set_rgb_cli                 (std::string_view args);
@@ -150,10 +285,90 @@ private:
     void                        turn_off_cli                ();
     void                        set_mode_cli                (std::string_view args);
     void                        set_length_cli              (std::string_view args);
+    void                        seg_add_cli                 (std::string_view args);
+    void                        seg_resize_cli              (std::string_view args);
+    void                        seg_remove_cli              (std::string_view args);
+    void                        seg_rgb_cli                 (std::string_view args);
+    void                        seg_brightness_cli          (std::string_view args);
+    void                        seg_mode_cli                (std::string_view args);
+    void                        seg_list_cli                ();
+    void                        pal_set_cli                 (std::string_view args);
+    void                        pal_select_cli              (std::string_view args);
+    void                        pal_remove_cli              (std::string_view args);
+    void                        pal_list_cli                ();
+    void                        power_budget_cli            (std::string_view args);
+    void                        benchmark_cli               ();
+    void                        stats_cli                   ();
+    void                        stats_reset_cli             ();
+    // output_range() cost allowed per frame during a crossfade, in 1/1000 of the frame interval.
+    // a target like LedModeInfo::frame_budget_permille, "$led benchmark" measures against it
+    static constexpr uint16_t   OUTPUT_PASS_BUDGET_PERMILLE = 50;
+
+    // segment table, guarded by led_mode_mutex and kept sorted by start
+    bool                        segment_range_free          (uint16_t start, uint16_t length, int skip_id) const;
+    void                        sort_segments               ();
+    void                        load_segments               ();
+    void                        save_segments               ();
+    std::vector                 <std::unique_ptr<Segment>>  segments;
+
+    // selected palette, guarded by led_mode_mutex
+    bool                        apply_palette               (const std::string& config);
+    Palette                     palette;
+    uint8_t                     palette_slot                = 0;
+
+    // power limit stage after Brightness: rendered frames are scaled with the estimate of the previous
+    // frame (power_scale_q16), solid frames with their own
+    PowerLimiter                power_limiter               {{LED_STRIP_CHANNEL_MA_R, LED_STRIP_CHANNEL_MA_G,
+                                                              LED_STRIP_CHANNEL_MA_B},
+                                                             LED_STRIP_IDLE_MA, LED_STRIP_POWER_BUDGET_MA};
+    uint32_t                    power_scale_q16             = PowerLimiter::SCALE_ONE;
+    // closed loop on the measured current (PIN_STRIP_ISENSE), trims the output on top of the estimate
+    std::unique_ptr             <CurrentSource>             current_source;
+    CurrentLimiter              current_limiter             {LED_STRIP_POWER_BUDGET_MA};
+    uint32_t                    output_scale_q16            () const;
 
-    std::unique_ptr             <AsyncTimer<uint8_t>>       frame_timer;
-    std::unique_ptr             <LedMode>                   led_mode;
+    // start of the last frame loop() ran, paces the frames when there is no render task
+    uint32_t                    last_frame_ms               = 0;
+    // modes live in two fixed slots: led_mode points into mode_slots[active_slot], a crossfade
+    // moves active_slot to the other slot and leaves the previous mode there as outgoing_mode
+    StripModeSlot               mode_slots                  [2];
+    uint8_t                     active_slot                 = 0;
+    LedMode*                    led_mode                    = nullptr;
+    // set_mode keeps the previous mode alive and blends it out over color_transition_delay
+    LedMode*                    outgoing_mode               = nullptr;
+    std::unique_ptr             <AsyncTimer<uint16_t>>      crossfade_timer;
     std::unique_ptr             <Brightness>                brightness;
 
-    uint32_t                    fps_counter                         =1;
+    // frame interval from the time FastLED needs to clock out the longest channel slice
+    static uint32_t             wire_time_us                (uint16_t length);
+    static uint8_t              auto_frame_delay            (uint16_t length);
+    void                        update_frame_delay          ();
+
+    // achieved frame rate, counted over one second windows
+    uint32_t                    fps_window_start_us         = 0;
+    uint32_t                    fps_window_frames           = 0;
+    uint32_t                    fps_achieved                = 0;
+
+    // frame tracking: skip show() when the dimmed frame content did not change. setters on other tasks
+    // mark the frame dirty, the render task takes the flag with exchange() so no mark is lost
+    std::atomic<bool>           frame_dirty                 {true};
+    CRGB16                      last_frame_level            = {0, 0, 0};
+    uint16_t                    last_frame_length           = 0;
+    std::vector<SegmentFrame>   frame_segments;
+    std::vector<SegmentFrame>   last_frame_segments;
+    uint32_t                    frames_pushed               = 0;
+    uint32_t                    frames_skipped              = 0;
+
+    // per stage timing of render_frame(), stage_done() records the time since the previous stage ended
+    void                        stage_done                  (FrameStage stage);
+#if LED_STRIP_FRAME_STATS
+    FrameStats                  frame_stats;
+    uint32_t                    stage_mark_us               = 0;
+#endif
+
+    // frame timing: deviation of the actual frame start from the configured period
+    uint32_t                    last_frame_start_us         = 0;
+    uint32_t                    jitter_max_us               = 0;
+    uint64_t                    jitter_sum_us               = 0;
+    uint32_t                    jitter_samples              = 0;
 };
@@ -0,0 +1,107 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: Palette.cpp
+#include "Palette.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+Palette::Palette() {
+    const PaletteStop rainbow[] = {
+        {0,   {255, 0, 0}},
+        {85,  {0, 255, 0}},
+        {170, {0, 0, 255}},
+        {255, {255, 0, 0}},
+    };
+    set_stops(rainbow, 4);
+}
+
+bool Palette::set_stops(const PaletteStop* new_stops, uint8_t count) {
+    DBG_PRINTF(Palette, "-> Palette::set_stops(count: %u)\n", count);
+    if (count == 0 || count > STOPS_MAX) return false;
+    for (uint8_t i = 1; i < count; i++) {
+        if (new_stops[i].position < new_stops[i - 1].position) return false;
+    }
+    std::copy(new_stops, new_stops + count, stops.begin());
+    stop_count = count;
+    expand();
+    DBG_PRINTLN(Palette, "<- Palette::set_stops()");
+    return true;
+}
+
+uint8_t Palette::get_stop_count() const {
+    return stop_count;
+}
+
+// entries before the first and after the last stop hold that stop's color,
+// between two stops each channel is interpolated linearly with rounding
+void Palette::expand() {
+    uint16_t index = 0;
+    for (; index < stops[0].position; index++) {
+        lut[index] = CRGB(stops[0].rgb[0], stops[0].rgb[1], stops[0].rgb[2]);
+    }
+    for (uint8_t s = 0; s + 1 < stop_count; s++) {
+        const PaletteStop& from = stops[s];
+        const PaletteStop& to   = stops[s + 1];
+        const int span = to.position - from.position;
+        for (; index < to.position; index++) {
+            const int t = index - from.position;
+            uint8_t channels[3];
+            for (uint8_t c = 0; c < 3; c++) {
+                channels[c] = from.rgb[c] + ((to.rgb[c] - from.rgb[c]) * t * 2 + (to.rgb[c] >= from.rgb[c] ? span : -span)) / (span * 2);
+            }
+            lut[index] = CRGB(channels[0], channels[1], channels[2]);
+        }
+    }
+    const PaletteStop& last = stops[stop_count - 1];
+    for (; index < 256; index++) {
+        lut[index] = CRGB(last.rgb[0], last.rgb[1], last.rgb[2]);
+    }
+}
+
+std::string Palette::to_config() const {
+    std::string config;
+    char stop_text[12];
+    for (uint8_t i = 0; i < stop_count; i++) {
+        snprintf(stop_text, sizeof(stop_text), "%s%u:%02X%02X%02X", i ? "," : "",
+                 stops[i].position, stops[i].rgb[0], stops[i].rgb[1], stops[i].rgb[2]);
+        config += stop_text;
+    }
+    return config;
+}
+
+bool Palette::parse_config(const std::string& config,
+                           std::array<PaletteStop, STOPS_MAX>& stops, uint8_t& count) {
+    count = 0;
+    size_t pos = 0;
+    while (pos < config.size()) {
+        if (count == STOPS_MAX) return false;
+        size_t end = config.find(',', pos);
+        if (end == std::string::npos) end = config.size();
+        std::string stop_text = config.substr(pos, end - pos);
+        size_t colon = stop_text.find(':');
+        if (colon == std::string::npos || stop_text.size() - colon - 1 != 6) return false;
+
+        char* parse_end = nullptr;
+        unsigned long position = strtoul(stop_text.c_str(), &parse_end, 10);
+        if (parse_end != stop_text.c_str() + colon || position > 255) return false;
+        unsigned long color = strtoul(stop_text.c_str() + colon + 1, &parse_end, 16);
+        if (*parse_end != '\0') return false;
+
+        stops[count].position = static_cast<uint8_t>(position);
+        stops[count].rgb = {static_cast<uint8_t>(color >> 16), static_cast<uint8_t>(color >> 8), static_cast<uint8_t>(color)};
+        if (count > 0 && stops[count].position < stops[count - 1].position) return false;
+        count++;
+        pos = end + 1;
+    }
+    return count > 0;
+}
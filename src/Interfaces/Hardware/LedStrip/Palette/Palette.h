@@ -0,0 +1,55 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: Palette.h
+#ifndef PALETTE_H
+#define PALETTE_H
+
+#include <FastLED.h>
+#include <array>
+#include <string>
+#include "../../../../Debug.h"
+
+struct PaletteStop {
+    uint8_t                 position        = 0;
+    std::array<uint8_t,3>   rgb             = {0, 0, 0};
+};
+
+// Gradient of up to STOPS_MAX color stops, expanded once into a 256 entry table,
+// so a mode samples it with one lookup per pixel
+class Palette {
+public:
+    static constexpr uint8_t STOPS_MAX      = 16;
+
+    // rainbow, used until a palette is selected
+    Palette                                 ();
+
+    // stops must be sorted by position, 1..STOPS_MAX of them
+    bool                    set_stops       (const PaletteStop* new_stops, uint8_t count);
+    uint8_t                 get_stop_count  () const;
+
+    const CRGB&             sample          (uint8_t index) const { return lut[index]; }
+    const CRGB*             data            () const { return lut.data(); }
+
+    // "<position>:<RRGGBB>,..." the form used by the CLI and stored in NVS
+    std::string             to_config       () const;
+    static bool             parse_config    (const std::string& config,
+                                             std::array<PaletteStop, STOPS_MAX>& stops, uint8_t& count);
+
+private:
+    void                    expand          ();
+
+    std::array<PaletteStop, STOPS_MAX>      stops;
+    uint8_t                                 stop_count  = 0;
+    std::array<CRGB, 256>                   lut;
+};
+
+#endif  // PALETTE_H
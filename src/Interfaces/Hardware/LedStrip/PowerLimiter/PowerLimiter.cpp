@@ -0,0 +1,68 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: PowerLimiter.cpp
+#include "PowerLimiter.h"
+
+#include <cstddef>
+
+// full output of a channel in 8.8 fixed point
+static constexpr uint32_t LEVEL_FULL_Q8 = 255u << 8;
+
+PowerLimiter::PowerLimiter(std::array<uint16_t, 3> channel_ma, uint16_t idle_ma, uint16_t budget_ma)
+    : channel_ma(channel_ma), idle_ma(idle_ma), budget_ma(budget_ma) {}
+
+void PowerLimiter::set_budget_ma(uint16_t new_budget_ma) {
+    budget_ma.store(new_budget_ma, std::memory_order_relaxed);
+}
+
+uint16_t PowerLimiter::get_budget_ma() const {
+    return budget_ma.load(std::memory_order_relaxed);
+}
+
+uint32_t PowerLimiter::estimate_ma(const std::array<uint32_t, 3>& level_sum_q8, uint16_t pixels) const {
+    uint64_t channel_draw = 0;
+    for (size_t i = 0; i < 3; i++) {
+        channel_draw += static_cast<uint64_t>(level_sum_q8[i]) * channel_ma[i];
+    }
+    return static_cast<uint32_t>(idle_ma) * pixels
+         + static_cast<uint32_t>((channel_draw + LEVEL_FULL_Q8 / 2) / LEVEL_FULL_Q8);
+}
+
+uint32_t PowerLimiter::limit_scale_q16(const std::array<uint32_t, 3>& level_sum_q8, uint16_t pixels) {
+    uint32_t idle_draw = static_cast<uint32_t>(idle_ma) * pixels;
+    uint32_t estimate  = estimate_ma(level_sum_q8, pixels);
+    uint32_t budget    = get_budget_ma();
+    uint32_t scale     = SCALE_ONE;
+    if (budget != 0 && estimate > budget) {
+        // estimate > budget > idle_draw keeps the divisor above zero
+        scale = budget > idle_draw
+              ? static_cast<uint32_t>(static_cast<uint64_t>(budget - idle_draw) * SCALE_ONE / (estimate - idle_draw))
+              : 0;
+        limited_frames.fetch_add(1, std::memory_order_relaxed);
+    }
+    estimated_ma.store(estimate, std::memory_order_relaxed);
+    limited_ma.store(idle_draw + static_cast<uint32_t>(static_cast<uint64_t>(estimate - idle_draw) * scale / SCALE_ONE),
+                     std::memory_order_relaxed);
+    return scale;
+}
+
+uint32_t PowerLimiter::get_estimated_ma() const {
+    return estimated_ma.load(std::memory_order_relaxed);
+}
+
+uint32_t PowerLimiter::get_limited_ma() const {
+    return limited_ma.load(std::memory_order_relaxed);
+}
+
+uint32_t PowerLimiter::get_limited_frames() const {
+    return limited_frames.load(std::memory_order_relaxed);
+}
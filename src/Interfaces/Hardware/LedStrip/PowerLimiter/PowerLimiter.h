@@ -0,0 +1,61 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: PowerLimiter.h
+#ifndef POWERLIMITER_H
+#define POWERLIMITER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Keeps the estimated strip current within a milliamp budget. The output pass sums the 8.8 output level
+// of every channel (after brightness, gamma and white balance), limit_scale_q16() turns the sums into a
+// current estimate and returns the scale that brings the frame into the budget. The scale is applied to
+// the output levels, where the current is linear in it, so one multiply per channel is exact.
+// The strip feeds it and applies the result
+class PowerLimiter {
+public:
+    static constexpr uint32_t   SCALE_ONE           = 65536;
+
+    PowerLimiter                                    (std::array<uint16_t, 3> channel_ma, uint16_t idle_ma,
+                                                     uint16_t budget_ma = 0);
+
+    // 0 disables the limit
+    void                        set_budget_ma       (uint16_t budget_ma);
+    uint16_t                    get_budget_ma       () const;
+
+    // current of pixels LEDs whose 8.8 channel levels add up to level_sum_q8
+    uint32_t                    estimate_ma         (const std::array<uint32_t, 3>& level_sum_q8, uint16_t pixels) const;
+    // q16 scale for the channel levels that keeps the estimate within the budget, SCALE_ONE when it fits.
+    // the idle current of the LED drivers can not be scaled away, a budget below it turns the strip dark
+    uint32_t                    limit_scale_q16     (const std::array<uint32_t, 3>& level_sum_q8, uint16_t pixels);
+
+    static uint16_t             apply               (uint16_t level_q8, uint32_t scale_q16) {
+        return static_cast<uint16_t>((static_cast<uint32_t>(level_q8) * scale_q16) >> 16);
+    }
+
+    // last limited frame: estimate before and after the limit, and the number of frames that were limited
+    uint32_t                    get_estimated_ma    () const;
+    uint32_t                    get_limited_ma      () const;
+    uint32_t                    get_limited_frames  () const;
+
+private:
+    std::array<uint16_t, 3>     channel_ma;
+    uint16_t                    idle_ma;
+    // written by the CLI, read by the render task
+    std::atomic<uint16_t>       budget_ma;
+    std::atomic<uint32_t>       estimated_ma        {0};
+    std::atomic<uint32_t>       limited_ma          {0};
+    std::atomic<uint32_t>       limited_frames      {0};
+};
+
+#endif  // POWERLIMITER_H
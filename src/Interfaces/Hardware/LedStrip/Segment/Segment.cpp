@@ -0,0 +1,177 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: Segment.cpp
+#include "Segment.h"
+#include "../LedModes/ColorSolid/ColorSolid.h"
+#include "../LedModes/ColorChanging/ColorChanging.h"
+
+#include <algorithm>
+#include <sstream>
+
+Segment::Segment(LedStrip* led_strip,
+                 uint16_t start, uint16_t length, bool reverse,
+                 std::array<uint8_t,3> rgb, uint8_t brightness,
+                 uint16_t color_transition_delay,
+                 uint16_t brightness_transition_delay,
+                 Easing color_easing,
+                 Easing brightness_easing)
+    : led_strip(led_strip),
+      start(start),
+      length(length),
+      reverse(reverse),
+      color_transition_delay(color_transition_delay),
+      color_easing(color_easing)
+{
+    DBG_PRINTF(Segment, "-> Segment::Segment(start: %u, length: %u, reverse: %u, rgb: {%u, %u, %u}, brightness: %u)\n",
+               start, length, reverse, rgb[0], rgb[1], rgb[2], brightness);
+    led_mode.emplace<ColorSolid>(led_strip, rgb[0], rgb[1], rgb[2]);
+    this->brightness = std::make_unique<Brightness>(brightness_transition_delay, brightness, 1, brightness_easing);
+    DBG_PRINTLN(Segment, "<- Segment::Segment()");
+}
+
+Segment::~Segment() {
+    DBG_PRINTLN(Segment, "-> Segment::~Segment()");
+    DBG_PRINTLN(Segment, "<- Segment::~Segment()");
+}
+
+// caller holds the strip led_mode_mutex
+void Segment::loop() {
+    led_mode->loop();
+    if (led_mode->get_mode_id() == ColorChanging::INFO.id && led_mode->is_done()) {
+        std::array<uint8_t,3> rgb = led_mode->get_rgb();
+        led_mode.emplace<ColorSolid>(led_strip, rgb[0], rgb[1], rgb[2]);
+    }
+}
+
+// dims by the segment brightness first, then by the strip brightness, so the strip state still wins
+bool Segment::is_static() const {
+    return led_mode->is_static() && !brightness->is_transitioning();
+}
+
+SegmentFrame Segment::get_frame(const BrightnessFrame& strip_brightness) const {
+    BrightnessFrame segment_brightness = brightness->get_frame();
+    CRGB16 rgb16 = led_mode->get_rgb16();
+    SegmentFrame frame;
+    frame.start  = start;
+    frame.length = length;
+    // both brightness levels are applied in 8.8, the output pass rounds to 8 bits once
+    for (size_t i = 0; i < 3; i++) {
+        frame.level[i] = strip_brightness.apply_q8(segment_brightness.apply_q8(rgb16[i]));
+    }
+    frame.uniform    = led_mode->is_uniform();
+    frame.brightness = strip_brightness.combined(segment_brightness);
+    return frame;
+}
+
+bool Segment::is_uniform() const { return led_mode->is_uniform(); }
+
+// caller holds the strip led_mode_mutex. pixels is the visible part of the zone: a zone running past the
+// strip end is clipped before it is rendered and reversed, so the mode never sees the off-strip LEDs
+void Segment::render(std::span<CRGB> pixels, FrameContext& ctx) {
+    led_mode->render(pixels, ctx);
+    if (reverse) std::reverse(pixels.begin(), pixels.end());
+}
+
+void Segment::set_range(uint16_t new_start, uint16_t new_length) {
+    DBG_PRINTF(Segment, "-> Segment::set_range(start: %u, length: %u)\n", new_start, new_length);
+    start  = new_start;
+    length = new_length;
+    DBG_PRINTLN(Segment, "<- Segment::set_range()");
+}
+
+void Segment::set_rgb(std::array<uint8_t,3> new_rgb) {
+    DBG_PRINTF(Segment, "-> Segment::set_rgb(rgb: {%u, %u, %u})\n", new_rgb[0], new_rgb[1], new_rgb[2]);
+    if (get_target_rgb() == new_rgb) return;
+    // spatial modes keep running and take the new color as their base, like the strip mode
+    if (!led_mode->is_uniform()) {
+        led_mode->set_rgb(new_rgb);
+        DBG_PRINTLN(Segment, "<- Segment::set_rgb() (spatial mode recolored)");
+        return;
+    }
+    std::array<uint8_t,3> old_rgb = led_mode->get_rgb();
+    led_mode.emplace<ColorChanging>(
+        led_strip,
+        old_rgb[0], old_rgb[1], old_rgb[2],
+        new_rgb[0], new_rgb[1], new_rgb[2],
+        'r',
+        color_transition_delay,
+        color_easing);
+    DBG_PRINTLN(Segment, "<- Segment::set_rgb()");
+}
+
+void Segment::set_brightness(uint8_t new_brightness) {
+    DBG_PRINTF(Segment, "-> Segment::set_brightness(brightness: %u)\n", new_brightness);
+    brightness->set_brightness(new_brightness);
+    DBG_PRINTLN(Segment, "<- Segment::set_brightness()");
+}
+
+// the new mode starts from the current color, unknown ids and the internal ColorChanging are refused
+bool Segment::set_mode(uint8_t mode_id) {
+    DBG_PRINTF(Segment, "-> Segment::set_mode(mode_id: %u)\n", mode_id);
+    const LedModeInfo* info = find_led_mode(mode_id);
+    if (!info || !info->create) {
+        DBG_PRINTLN(Segment, "<- Segment::set_mode() (unknown mode)");
+        return false;
+    }
+    if (mode_id != get_mode_id()) led_mode.emplace(*info, led_strip, get_target_rgb());
+    DBG_PRINTLN(Segment, "<- Segment::set_mode()");
+    return true;
+}
+
+uint16_t Segment::get_start() const { return start; }
+
+uint16_t Segment::get_length() const { return length; }
+
+uint16_t Segment::get_end() const { return start + length; }
+
+bool Segment::is_reversed() const { return reverse; }
+
+std::array<uint8_t,3> Segment::get_rgb() const { return led_mode->get_rgb(); }
+
+std::array<uint8_t,3> Segment::get_target_rgb() const { return led_mode->get_target_rgb(); }
+
+uint8_t Segment::get_brightness() const { return brightness->get_target_value(); }
+
+std::string Segment::get_mode_name() const { return led_mode->get_mode_name(); }
+
+// the selected mode, a running color transition reports ColorSolid
+uint8_t Segment::get_mode_id() const { return led_mode->get_target_mode_id(); }
+
+std::string Segment::to_config() const {
+    std::array<uint8_t,3> rgb = get_target_rgb();
+    std::stringstream config;
+    config << start << " " << length << " " << (reverse ? 1 : 0) << " "
+           << static_cast<int>(rgb[0]) << " " << static_cast<int>(rgb[1]) << " " << static_cast<int>(rgb[2]) << " "
+           << static_cast<int>(get_brightness()) << " "
+           << static_cast<int>(get_mode_id());
+    return config.str();
+}
+
+bool Segment::parse_config(const std::string& config,
+                           uint16_t& start, uint16_t& length, bool& reverse,
+                           std::array<uint8_t,3>& rgb, uint8_t& brightness, uint8_t& mode_id) {
+    std::istringstream in(config);
+    unsigned values[7];
+    for (unsigned& value : values) {
+        if (!(in >> value)) return false;
+    }
+    if (values[1] == 0 || values[0] + values[1] > LED_STRIP_NUM_LEDS_MAX) return false;
+    start      = values[0];
+    length     = values[1];
+    reverse    = values[2] != 0;
+    rgb        = {static_cast<uint8_t>(values[3]), static_cast<uint8_t>(values[4]), static_cast<uint8_t>(values[5])};
+    brightness = static_cast<uint8_t>(values[6]);
+    unsigned mode = ColorSolid::INFO.id;
+    if (in >> mode && mode > 255) return false;
+    mode_id    = static_cast<uint8_t>(mode);
+    return true;
+}
@@ -0,0 +1,99 @@
+/*********************************************************************************
+ *  SPDX-License-Identifier: LicenseRef-PolyForm-NC-1.0.0-NoAI
+ *
+ *  Licensed under PolyForm Noncommercial 1.0.0 + No AI Use Addendum v1.0.
+ *  See: LICENSE and LICENSE-NO-AI.md in the project root for full terms.
+ *
+ *  Required Notice: Copyright 2025 Maxim Dokukin (https://maxdokukin.com)
+ *  https://github.com/maxdokukin/XeWe-LED-OS
+ *********************************************************************************/
+
+
+// File: Segment.h
+#ifndef SEGMENT_H
+#define SEGMENT_H
+
+#include <FastLED.h>
+#include <memory>
+#include <array>
+#include <string>
+#include <span>
+#include "../../../../Config.h"
+#include "../../../../Debug.h"
+#include "../Brightness/Brightness.h"
+#include "../LedModes/LedMode.h"
+#include "../LedModes/LedModeRegistry.h"
+
+class LedStrip;
+
+// Per-frame snapshot of a segment: the range it covers and its fully dimmed color in 8.8 fixed point.
+// A segment running a spatial mode is not uniform, it is rendered per pixel with the combined brightness
+struct SegmentFrame {
+    uint16_t                start                   = 0;
+    uint16_t                length                  = 0;
+    CRGB16                  level                   = {0, 0, 0};
+    bool                    uniform                 = true;
+    BrightnessFrame         brightness              = {};
+
+    bool operator==(const SegmentFrame& other) const {
+        return start == other.start && length == other.length && level == other.level && uniform == other.uniform;
+    }
+};
+
+// A zone of the strip with its own mode, color transition and brightness.
+// Segments are drawn on top of the strip wide mode, which stays the base layer.
+class Segment {
+public:
+    Segment                                 (LedStrip* led_strip,
+                                             uint16_t start, uint16_t length, bool reverse,
+                                             std::array<uint8_t,3> rgb, uint8_t brightness,
+                                             uint16_t color_transition_delay,
+                                             uint16_t brightness_transition_delay,
+                                             Easing color_easing = Easing::LINEAR,
+                                             Easing brightness_easing = Easing::LINEAR);
+    ~Segment                                ();
+
+    void                    loop            ();
+    SegmentFrame            get_frame       (const BrightnessFrame& strip_brightness) const;
+    // no color or brightness transition running
+    bool                    is_static       () const;
+    bool                    is_uniform      () const;
+    // renders the zone into pixels, which start at the first LED of the zone, in strip order
+    void                    render          (std::span<CRGB> pixels, FrameContext& ctx);
+
+    void                    set_range       (uint16_t start, uint16_t length);
+    void                    set_rgb         (std::array<uint8_t,3> new_rgb);
+    void                    set_brightness  (uint8_t new_brightness);
+    bool                    set_mode        (uint8_t mode_id);
+
+    uint16_t                get_start       () const;
+    uint16_t                get_length      () const;
+    uint16_t                get_end         () const;
+    bool                    is_reversed     () const;
+    std::array<uint8_t,3>   get_rgb         () const;
+    std::array<uint8_t,3>   get_target_rgb  () const;
+    uint8_t                 get_brightness  () const;
+    std::string             get_mode_name   () const;
+    uint8_t                 get_mode_id     () const;
+
+    // "<start> <length> <reverse> <r> <g> <b> <brightness> <mode>", the form stored in NVS.
+    // configs saved before segments had modes have no <mode> and load as ColorSolid
+    std::string             to_config       () const;
+    static bool             parse_config    (const std::string& config,
+                                             uint16_t& start, uint16_t& length, bool& reverse,
+                                             std::array<uint8_t,3>& rgb, uint8_t& brightness, uint8_t& mode_id);
+
+private:
+    LedStrip*                               led_strip;
+    uint16_t                                start;
+    uint16_t                                length;
+    // pixel i of the mode lands on LED start + visible - 1 - i, visible being the part of the zone inside
+    // the strip (the whole length unless it runs past the end); solid colors look the same either way
+    bool                                    reverse;
+    uint16_t                                color_transition_delay;
+    Easing                                  color_easing;
+    SegmentModeSlot                         led_mode;
+    std::unique_ptr<Brightness>             brightness;
+};
+
+#endif  // SEGMENT_H
@@ -86,6 +86,7 @@ void Web::begin_routines_required (const ModuleConfig& cfg) {
     httpServer.on("/state",   HTTP_GET, std::bind(&Web::handleGetStateRequest,this));
     httpServer.on("/modes",   HTTP_GET, std::bind(&Web::handleGetModesRequest,this));
     httpServer.on("/name",    HTTP_GET, std::bind(&Web::handleGetNameRequest, this));
+    httpServer.on("/stats",   HTTP_GET, std::bind(&Web::handleGetStatsRequest,this));
 }
 
 void Web::begin_routines_regular (const ModuleConfig& cfg) {
@@ -194,8 +195,7 @@ void Web::handleGetStateRequest() {
 void Web::handleGetModesRequest() {
     if (is_disabled()) return;
 
-    std::string modes_json = controller.led_strip.get_all_modes_list();
-    httpServer.send(200, "application/json", modes_json.c_str());
+    httpServer.send(200, "application/json", controller.led_strip.get_all_modes_list());
 }
 
 void Web::handleGetNameRequest() {
@@ -204,6 +204,12 @@ void Web::handleGetNameRequest() {
     httpServer.send(200, "text/plain", controller.system.get_device_name().c_str());
 }
 
+void Web::handleGetStatsRequest() {
+    if (is_disabled()) return;
+
+    httpServer.send(200, "application/json", controller.led_strip.get_frame_stats_json().c_str());
+}
+
 void Web::webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t /*length*/) {
     if (is_disabled()) return;
 
@@ -271,6 +277,11 @@ const char Web::INDEX_HTML[] PROGMEM = R"rawliteral(
   button { padding:.75rem; background:var(--accent); border:none; border-radius:5px; color:var(--bg); font-size:1rem; font-weight:500; cursor:pointer; transition:opacity .2s ease; }
   button:disabled { opacity:.4; cursor:not-allowed; }
 
+  /* frame stats, polled from /stats while open */
+  details { font-size:.85rem; color:#b7bdc9; }
+  summary { cursor:pointer; }
+  #stats-text { margin-top:.5rem; font-family:ui-monospace, monospace; white-space:pre; overflow-x:auto; }
+
   /* === Fancy range sliders (from reference style) === */
   .range-wrap{ position:relative; display:grid; align-items:center; }
   .bubble{ position:absolute; right:0; top:-22px; font-size:.8rem; color:#b7bdc9; pointer-events:none; }
@@ -342,6 +353,11 @@ const char Web::INDEX_HTML[] PROGMEM = R"rawliteral(
       <button id="btnOn">On</button>
       <button id="btnOff">Off</button>
     </div>
+
+    <details id="stats">
+      <summary>Frame stats</summary>
+      <div id="stats-text">Loading…</div>
+    </details>
   </section>
 
 
@@ -358,7 +374,9 @@ const char Web::INDEX_HTML[] PROGMEM = R"rawliteral(
       btnOff: document.getElementById('btnOff'),
       statusIndicator: document.getElementById('status-indicator'),
       statusText: document.getElementById('status-text'),
-      deviceTitle: document.getElementById('device-title')   // <-- NEW
+      deviceTitle: document.getElementById('device-title'),  // <-- NEW
+      stats: document.getElementById('stats'),
+      statsText: document.getElementById('stats-text')
     };
 
 
@@ -474,6 +492,27 @@ const char Web::INDEX_HTML[] PROGMEM = R"rawliteral(
     }
   }
 
+  // --- Frame stats: per stage frame time in us, see $led stats ---
+  const STATS_POLL_MS = 2000;
+  async function loadStats(){
+    if (!elements.stats.open) return;
+    try {
+      const res = await fetch('/stats', { cache: 'no-store' });
+      if (!res.ok) throw new Error(`HTTP ${res.status}`);
+      const st = await res.json();
+      if (!st.enabled) { elements.statsText.textContent = 'Compiled out (LED_STRIP_FRAME_STATS 0)'; return; }
+      const col = (x, w) => String(x).padStart(w);
+      let txt = `period ${st.period_us} us, ${st.pushed} pushed, ${st.skipped} skipped, ${st.dropped} dropped\n`
+              + `stage        count     min     avg     p99     max\n`;
+      for (const [name, s] of Object.entries(st.stages)) {
+        txt += name.padEnd(8) + col(s.count, 9) + col(s.min, 8) + col(s.avg, 8) + col(s.p99, 8) + col(s.max, 8) + '\n';
+      }
+      elements.statsText.textContent = txt;
+    } catch (e) {
+      console.warn('Failed to load stats:', e);
+    }
+  }
+
   // --- Networking (same endpoints) ---
   function connect(){
     if (ws && (ws.readyState === ws.CONNECTING || ws.readyState === ws.OPEN)) return;
@@ -575,6 +614,8 @@ const char Web::INDEX_HTML[] PROGMEM = R"rawliteral(
     });
 
     elements.mode.addEventListener('change', () => sendCommand('mode_id', elements.mode.value));
+    elements.stats.addEventListener('toggle', loadStats);
+    setInterval(loadStats, STATS_POLL_MS);
 
     // initial visuals
     elements.hue.value = String(STATE.hue);
@@ -78,6 +78,7 @@ private:
     void                        handleGetStateRequest       ();
     void                        handleGetModesRequest       ();
     void                        handleGetNameRequest        ();
+    void                        handleGetStatsRequest       ();
 
     // WS handler
     void                        webSocketEvent              (uint8_t num,
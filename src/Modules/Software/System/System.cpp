@@ -14,6 +14,9 @@
 
 #include "System.h"
 #include "../../../SystemController/SystemController.h"
+#if SYSTEM_POWER_SAVE
+#include "esp_pm.h"
+#endif
 
 
 System::System(SystemController& controller)
@@ -65,6 +68,19 @@ void System::begin_routines_required (const ModuleConfig& cfg) {
     controller.serial_port.print_centered("Serial Port CLI");
     controller.serial_port.print_centered("Physical Buttons");
     controller.serial_port.print_spacer();
+
+#if SYSTEM_POWER_SAVE
+    // scale the clock down and light sleep whenever every task is blocked, the parked render task
+    // and the idle system loop leave most ticks free
+    esp_pm_config_t pm_config = {
+        .max_freq_mhz       = static_cast<int>(getCpuFrequencyMhz()),
+        .min_freq_mhz       = static_cast<int>(getXtalFrequencyMhz()),
+        .light_sleep_enable = true
+    };
+    if (esp_pm_configure(&pm_config) != ESP_OK) {
+        DBG_PRINTLN(System, "ERROR: esp_pm_configure failed, power save needs CONFIG_PM_ENABLE");
+    }
+#endif
 }
 
 void System::begin_routines_init (const ModuleConfig& cfg) {
@@ -103,4 +119,34 @@ void System::begin_routines_init (const ModuleConfig& cfg) {
     DBG_PRINTLN(System, "System->init_setup(): Complete.");
 }
 
+std::string System::status (const bool verbose) const {
+    bool measured = false;
+    uint32_t strip_ma = controller.led_strip.get_current_ma(measured);
+    uint16_t busy     = controller.get_busy_permille();
+    uint16_t load     = 0;
+    bool has_load     = controller.get_cpu_load_permille(load);
+    std::string load_text = has_load ? std::to_string(load / 10) + "." + std::to_string(load % 10) + "% (idle task run time)"
+                                     : std::string("n/a, needs CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS");
+    uint32_t uptime_s = millis() / 1000;
+
+    std::stringstream status_stream;
+    status_stream << "+------------------------------------------------+\n"
+                  << "|                 System Status                  |\n"
+                  << "+------------------------------------------------+\n"
+                  << "    Uptime:       " << uptime_s / 86400 << "d " << uptime_s / 3600 % 24 << "h "
+                  << uptime_s / 60 % 60 << "m " << uptime_s % 60 << "s\n"
+                  << "    Free heap:    " << ESP.getFreeHeap() << " bytes\n"
+                  << "    CPU load:     " << load_text << "\n"
+                  << "    Loop busy:    " << busy / 10 << "." << busy % 10 << "% (main loop incl. blocking calls, render task)\n"
+                  << "    LED render:   " << (controller.led_strip.is_idle() ? "parked on a static frame" : "running") << "\n"
+                  << "    LED power:    " << strip_ma << " mA " << (measured ? "measured" : "estimated") << ", "
+                  << static_cast<uint64_t>(strip_ma) * LED_STRIP_SUPPLY_MV / 1000 << " mW at "
+                  << LED_STRIP_SUPPLY_MV << " mV, strip only\n"
+                  << "    Power save:   " << (SYSTEM_POWER_SAVE ? "light sleep" : "off") << "\n"
+                  << "+------------------------------------------------+\n";
+    std::string status_string = status_stream.str();
+    if (verbose) controller.serial_port.print(status_string.c_str());
+    return status_string;
+}
+
 std::string System::get_device_name () { return controller.nvs.read_str(nvs_key, "dname"); };
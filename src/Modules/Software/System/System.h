@@ -13,6 +13,8 @@
 // src/Modules/Software/System/System.h
 #pragma once
 
+#include <sstream>
+
 #include "../../Module/Module.h"
 #include "../../../Config.h"
 #include "../../../Debug.h"
@@ -27,6 +29,7 @@ public:
 
     void                        begin_routines_required     (const ModuleConfig& cfg)       override;
     void                        begin_routines_init         (const ModuleConfig& cfg)       override;
+    std::string                 status                      (const bool verbose=false)      const override;
 
     // other methods
     std::string                 get_device_name             ();
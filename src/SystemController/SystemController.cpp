@@ -93,12 +93,53 @@ void SystemController::begin() {
 }
 
 void SystemController::loop() {
+    uint32_t start_us = micros();
     for (size_t i = 0; i < MODULE_COUNT; ++i) {
         modules[i]->loop();
     }
     if (serial_port.has_line()) {
         command_parser.parse(serial_port.read_line());
     }
+    uint32_t now_us = micros();
+    loop_busy_us += now_us - start_us;
+
+    uint32_t window_us = now_us - load_window_start_us;
+    if (window_us >= 1000000) {
+        uint32_t render_us = led_strip.get_render_busy_us();
+        uint64_t busy_us   = static_cast<uint64_t>(loop_busy_us) + (render_us - load_window_render_us);
+        busy_permille         = static_cast<uint16_t>(std::min<uint64_t>(busy_us * 1000 / window_us, 1000));
+        loop_busy_us          = 0;
+        load_window_render_us = render_us;
+        load_window_start_us  = now_us;
+#if configGENERATE_RUN_TIME_STATS
+        // the idle task only runs when nothing else is ready, its share of the run time is the idle CPU
+        uint64_t idle_time = ulTaskGetIdleRunTimeCounter();
+        uint64_t run_time  = portGET_RUN_TIME_COUNTER_VALUE();
+        uint64_t idle      = idle_time - load_window_idle_time;
+        uint64_t total     = run_time - load_window_run_time;
+        cpu_load_permille     = total ? static_cast<uint16_t>(1000 - std::min<uint64_t>(idle * 1000 / total, 1000)) : 0;
+        load_window_idle_time = idle_time;
+        load_window_run_time  = run_time;
+#endif
+    }
+
+    // with the strip parked nothing is due before the next network or serial event,
+    // yield so the idle task (and light sleep with SYSTEM_POWER_SAVE) gets the CPU
+    if (led_strip.is_idle()) vTaskDelay(pdMS_TO_TICKS(SYSTEM_IDLE_LOOP_MS));
+}
+
+uint16_t SystemController::get_busy_permille() const {
+    return busy_permille;
+}
+
+bool SystemController::get_cpu_load_permille(uint16_t& load_permille) const {
+#if configGENERATE_RUN_TIME_STATS
+    load_permille = cpu_load_permille;
+    return true;
+#else
+    load_permille = 0;
+    return false;
+#endif
 }
 
 void SystemController::sync_color(std::array<uint8_t,3> color, const std::array<uint8_t,INTERFACE_COUNT>& sync_flags) {
@@ -18,6 +18,7 @@
 #include <vector>
 #include <array>
 #include <utility>
+#include <algorithm>
 
 #include "../StringUtils.h"
 
@@ -63,6 +64,13 @@ public:
                                                              const uint16_t length,
                                                              const std::array<uint8_t,INTERFACE_COUNT>& sync_flags);
 
+    // share of the last second the main loop and the render task were busy, in 0.1 %. wall time, so
+    // blocking calls in the loop (network, NVS) count as busy: not the CPU load, it tells if the loop idles
+    uint16_t                    get_busy_permille           () const;
+    // share of the last second the CPU did not spend in the FreeRTOS idle task, in 0.1 %, from the
+    // run time counters. false when the sdkconfig builds FreeRTOS without run time stats
+    bool                        get_cpu_load_permille       (uint16_t& load_permille) const;
+
     SerialPort                  serial_port;
     Nvs                         nvs;
     System                      system;
@@ -83,6 +91,15 @@ private:
     Interface*                  interfaces                  [INTERFACE_COUNT] = {};
 
     std::vector<CommandsGroup>  command_groups;
+
+    // busy time accounting for get_busy_permille(), evaluated once per second
+    uint32_t                    loop_busy_us                = 0;
+    uint32_t                    load_window_start_us        = 0;
+    uint32_t                    load_window_render_us       = 0;
+    uint16_t                    busy_permille               = 0;
+    uint64_t                    load_window_idle_time       = 0;
+    uint64_t                    load_window_run_time        = 0;
+    uint16_t                    cpu_load_permille           = 0;
 };
 
 template <typename Fn>